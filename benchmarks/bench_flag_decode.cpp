@@ -0,0 +1,90 @@
+/**
+ * @file bench_flag_decode.cpp
+ * @brief Measures SmartFlagEnum::TryFromValue on combined values.
+ *
+ * The baseline re-creates the previous decode, which copied List(), sorted it
+ * by value and OR'ed every flag together on each call. TryFromValue now walks
+ * the frozen value index and tests a precomputed mask instead.
+ */
+
+#include <SmartEnumCpp/SmartFlagEnum.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class EventFlag : public SmartFlagEnum<EventFlag, std::uint32_t> {
+public:
+    static void Define(int count) {
+        for (int i = 0; i < count; ++i) {
+            new EventFlag("Flag" + std::to_string(i), std::uint32_t(1) << i);
+        }
+    }
+
+private:
+    EventFlag(const std::string& name, std::uint32_t value) : SmartFlagEnum(name, value) {}
+};
+
+// The decode as it was before the plan was precomputed.
+static bool baselineDecode(std::uint32_t value, std::vector<const EventFlag*>& out) {
+    out.clear();
+    std::uint32_t allFlags = 0;
+    for (const EventFlag* flag : EventFlag::List()) {
+        allFlags |= flag->Value();
+    }
+    if ((value & ~allFlags) != 0) {
+        return false;
+    }
+    std::vector<const EventFlag*> sorted = EventFlag::List();
+    std::sort(sorted.begin(), sorted.end(),
+              [](const EventFlag* a, const EventFlag* b) { return a->Value() > b->Value(); });
+    std::uint32_t remaining = value;
+    for (const EventFlag* flag : sorted) {
+        if ((remaining & flag->Value()) == flag->Value()) {
+            out.push_back(flag);
+            remaining &= ~flag->Value();
+        }
+        if (remaining == 0) {
+            break;
+        }
+    }
+    return remaining == 0;
+}
+
+int main() {
+    const int flagCount = 24;
+    EventFlag::Define(flagCount);
+
+    // Combined values with a handful of bits set, as a logger sees them.
+    std::vector<std::uint32_t> inputs;
+    for (std::uint32_t i = 1; i <= 4096; ++i) {
+        inputs.push_back(((i * 2654435761u) >> 8) & ((1u << flagCount) - 1) & 0x00f0f0f3u);
+    }
+
+    std::vector<const EventFlag*> out;
+    out.reserve(flagCount);
+    const int rounds = 200;
+    std::size_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (std::uint32_t value : inputs) {
+            sink += baselineDecode(value, out) ? out.size() : 0;
+        }
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (std::uint32_t value : inputs) {
+            sink += EventFlag::TryFromValue(value, out) ? out.size() : 0;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    const double decodes = static_cast<double>(rounds) * inputs.size();
+    std::printf("%d flags  copy+sort %7.1f ns  TryFromValue %7.1f ns  (sink %zu)\n", flagCount,
+                std::chrono::duration<double, std::nano>(mid - start).count() / decodes,
+                std::chrono::duration<double, std::nano>(end - mid).count() / decodes, sink);
+    return 0;
+}
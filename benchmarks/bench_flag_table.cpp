@@ -0,0 +1,84 @@
+/**
+ * @file bench_flag_table.cpp
+ * @brief Measures UseFlagEnumLookupTable on an 8-bit status register.
+ *
+ * The same flags are defined twice, once decoded on demand and once through
+ * the full 256-entry table built at freeze time, and both decode and format
+ * every register value.
+ */
+
+#include <SmartEnumCpp/SmartFlagEnum.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+template <typename TEnum>
+class StatusFlags : public SmartFlagEnum<TEnum, std::uint8_t> {
+public:
+    static void Define() {
+        static const char* const names[] = {"Ready", "Busy", "TxEmpty", "RxFull", "Overrun", "Parity", "Framing"};
+        for (int i = 0; i < 7; ++i) {
+            new TEnum(names[i], std::uint8_t(1u << i));
+        }
+        new TEnum("ReadyBusy", std::uint8_t(3));
+        new TEnum("LineError", std::uint8_t(0x70));
+    }
+
+protected:
+    StatusFlags(const std::string& name, std::uint8_t value) : SmartFlagEnum<TEnum, std::uint8_t>(name, value) {}
+};
+
+class OnDemandStatus : public StatusFlags<OnDemandStatus> {
+public:
+    OnDemandStatus(const std::string& name, std::uint8_t value) : StatusFlags(name, value) {}
+};
+
+class TabledStatus : public StatusFlags<TabledStatus>, public UseFlagEnumLookupTable {
+public:
+    TabledStatus(const std::string& name, std::uint8_t value) : StatusFlags(name, value) {}
+};
+
+template <typename TEnum>
+static void run(const char* label, const std::vector<std::uint8_t>& inputs, int rounds) {
+    std::vector<const TEnum*> flags;
+    flags.reserve(8);
+    std::string text;
+    text.reserve(64);
+    std::size_t sink = 0;
+
+    TEnum::Freeze();
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (std::uint8_t value : inputs) {
+            sink += TEnum::TryFromValue(value, flags) ? flags.size() : 0;
+        }
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (std::uint8_t value : inputs) {
+            sink += TEnum::TryFromValueToString(value, text) ? text.size() : 0;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    const double calls = static_cast<double>(rounds) * inputs.size();
+    std::printf("%-10s TryFromValue %6.1f ns  TryFromValueToString %6.1f ns  (sink %zu)\n", label,
+                std::chrono::duration<double, std::nano>(mid - start).count() / calls,
+                std::chrono::duration<double, std::nano>(end - mid).count() / calls, sink);
+}
+
+int main() {
+    OnDemandStatus::Define();
+    TabledStatus::Define();
+
+    std::vector<std::uint8_t> inputs;
+    for (std::uint32_t i = 1; i <= 4096; ++i) {
+        inputs.push_back(static_cast<std::uint8_t>((i * 2654435761u) >> 24));
+    }
+
+    run<OnDemandStatus>("on demand", inputs, 200);
+    run<TabledStatus>("table", inputs, 200);
+    return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file bench_for_each_flag.cpp
+ * @brief Measures ForEachFlag against FromValue followed by a SwitchOn per flag.
+ *
+ * The baseline is the usual way to run a handler per advertised flag: decode
+ * the combined value into a vector, then branch on each element. ForEachFlag
+ * walks the set bits with count-trailing-zeros and calls the handler from a
+ * prebuilt EnumDispatcher instead.
+ */
+
+#include <SmartEnumCpp/SmartFlagEnum.hpp>
+#include <SmartEnumCpp/SmartEnumSwitch.hpp>
+#include <SmartEnumCpp/EnumDispatcher.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+class PeerCapability : public SmartFlagEnum<PeerCapability, std::uint32_t> {
+public:
+    static const PeerCapability Compression;
+    static const PeerCapability Encryption;
+    static const PeerCapability Multiplexing;
+    static const PeerCapability Resume;
+    static const PeerCapability Priority;
+    static const PeerCapability Push;
+    static const PeerCapability Metrics;
+    static const PeerCapability Tracing;
+
+private:
+    PeerCapability(const std::string& name, std::uint32_t value) : SmartFlagEnum(name, value) {}
+};
+const PeerCapability PeerCapability::Compression("Compression", 1u << 0);
+const PeerCapability PeerCapability::Encryption("Encryption", 1u << 1);
+const PeerCapability PeerCapability::Multiplexing("Multiplexing", 1u << 2);
+const PeerCapability PeerCapability::Resume("Resume", 1u << 3);
+const PeerCapability PeerCapability::Priority("Priority", 1u << 4);
+const PeerCapability PeerCapability::Push("Push", 1u << 5);
+const PeerCapability PeerCapability::Metrics("Metrics", 1u << 6);
+const PeerCapability PeerCapability::Tracing("Tracing", 1u << 7);
+
+static void baseline(std::uint32_t value, long& acc) {
+    for (const PeerCapability* capability : PeerCapability::FromValue(value)) {
+        SwitchOn(*capability)
+            .When(PeerCapability::Compression).Then([&] { acc += 1; })
+            .When(PeerCapability::Encryption).Then([&] { acc += 2; })
+            .When(PeerCapability::Multiplexing).Then([&] { acc += 3; })
+            .When(PeerCapability::Resume).Then([&] { acc += 4; })
+            .When(PeerCapability::Priority).Then([&] { acc += 5; })
+            .When(PeerCapability::Push).Then([&] { acc += 6; })
+            .When(PeerCapability::Metrics).Then([&] { acc += 7; })
+            .Default([&] { acc += 8; });
+    }
+}
+
+int main() {
+    const auto onCapability = EnumDispatcher<PeerCapability, void(long&)>()
+        .On(PeerCapability::Compression, [](long& acc) { acc += 1; })
+        .On(PeerCapability::Encryption, [](long& acc) { acc += 2; })
+        .On(PeerCapability::Multiplexing, [](long& acc) { acc += 3; })
+        .On(PeerCapability::Resume, [](long& acc) { acc += 4; })
+        .On(PeerCapability::Priority, [](long& acc) { acc += 5; })
+        .On(PeerCapability::Push, [](long& acc) { acc += 6; })
+        .On(PeerCapability::Metrics, [](long& acc) { acc += 7; })
+        .Default([](long& acc) { acc += 8; });
+
+    // Non-empty advertisements with a few capabilities each.
+    std::vector<std::uint32_t> inputs;
+    for (std::uint32_t i = 1; i <= 4096; ++i) {
+        inputs.push_back((((i * 2654435761u) >> 12) & 0xffu) | 1u);
+    }
+
+    const int rounds = 200;
+    long baselineSum = 0;
+    long dispatchedSum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (std::uint32_t value : inputs) {
+            baseline(value, baselineSum);
+        }
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (std::uint32_t value : inputs) {
+            ForEachFlag(value, onCapability, dispatchedSum);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    const double calls = static_cast<double>(rounds) * inputs.size();
+    std::printf("FromValue + SwitchOn %6.1f ns  ForEachFlag %6.1f ns  per value  (sums %ld %ld)\n",
+                std::chrono::duration<double, std::nano>(mid - start).count() / calls,
+                std::chrono::duration<double, std::nano>(end - mid).count() / calls,
+                baselineSum, dispatchedSum);
+    return baselineSum == dispatchedSum ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file bench_name_lookup.cpp
+ * @brief Compares name lookups through PerfectNameHash, the frozen sorted index and std::map.
+ *
+ * Each size is measured for exact and case-insensitive lookups over a mix of
+ * hits and misses.
+ */
+
+#include <SmartEnumCpp/PerfectNameHash.hpp>
+#include <SmartEnumCpp/SmartEnum.hpp>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+// Compile-time storage for N generated names ("Field0000", "Field0001", ...).
+template <std::size_t N>
+struct GeneratedNames {
+    char storage[N][10]{};
+
+    constexpr GeneratedNames() {
+        for (std::size_t i = 0; i < N; ++i) {
+            const char prefix[] = "Field";
+            for (std::size_t c = 0; c < 5; ++c) {
+                storage[i][c] = prefix[c];
+            }
+            std::size_t v = i;
+            for (std::size_t d = 9; d-- > 5;) {
+                storage[i][d] = static_cast<char>('0' + v % 10);
+                v /= 10;
+            }
+        }
+    }
+};
+
+template <std::size_t N>
+inline constexpr GeneratedNames<N> kNames{};
+
+template <std::size_t N>
+constexpr std::array<std::string_view, N> nameViews() {
+    std::array<std::string_view, N> views{};
+    for (std::size_t i = 0; i < N; ++i) {
+        views[i] = std::string_view(kNames<N>.storage[i], 9);
+    }
+    return views;
+}
+
+template <std::size_t N>
+class HashedField : public SmartEnum<HashedField<N>> {
+public:
+    static constexpr PerfectNameHash<N> NameHash{nameViews<N>()};
+    HashedField(const std::string& name, int value) : SmartEnum<HashedField<N>>(name, value) {}
+};
+
+template <std::size_t N>
+class SortedField : public SmartEnum<SortedField<N>> {
+public:
+    SortedField(const std::string& name, int value) : SmartEnum<SortedField<N>>(name, value) {}
+};
+
+template <typename F>
+static double nsPerLookup(const std::vector<std::string>& inputs, int rounds, F&& lookup) {
+    std::size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (const std::string& input : inputs) {
+            sink += lookup(input) ? 1 : 0;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    if (sink == 42) {
+        std::puts("");
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(rounds) * inputs.size());
+}
+
+template <std::size_t N>
+static void run() {
+    std::map<std::string, const SortedField<N>*, std::less<>> baseline;
+    for (std::string_view name : nameViews<N>()) {
+        new HashedField<N>(std::string(name), 0);
+        baseline[std::string(name)] = new SortedField<N>(std::string(name), 0);
+    }
+    HashedField<N>::Freeze();
+    SortedField<N>::Freeze();
+
+    std::vector<std::string> exact;
+    std::vector<std::string> folded;
+    for (std::size_t i = 0; i < 4096; ++i) {
+        std::string name(nameViews<N>()[(i * 7919) % N]);
+        if (i % 8 == 0) {
+            name.back() = 'x'; // miss
+        }
+        exact.push_back(name);
+        for (char& c : name) {
+            c = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 32) : c;
+        }
+        folded.push_back(name);
+    }
+
+    const int rounds = 500;
+    const double mapNs = nsPerLookup(exact, rounds, [&](const std::string& s) { return baseline.find(s) != baseline.end(); });
+    const double sortedNs = nsPerLookup(exact, rounds, [](const std::string& s) {
+        const SortedField<N>* out = nullptr;
+        return SortedField<N>::TryFromName(s, out);
+    });
+    const double hashedNs = nsPerLookup(exact, rounds, [](const std::string& s) {
+        const HashedField<N>* out = nullptr;
+        return HashedField<N>::TryFromName(s, out);
+    });
+    const double sortedFoldNs = nsPerLookup(folded, rounds, [](const std::string& s) {
+        const SortedField<N>* out = nullptr;
+        return SortedField<N>::TryFromName(s, out, true);
+    });
+    const double hashedFoldNs = nsPerLookup(folded, rounds, [](const std::string& s) {
+        const HashedField<N>* out = nullptr;
+        return HashedField<N>::TryFromName(s, out, true);
+    });
+
+    std::printf("%5zu names  std::map %6.2f ns  sorted %6.2f ns  hashed %6.2f ns  |  ignoreCase sorted %6.2f ns  hashed %6.2f ns\n",
+                N, mapNs, sortedNs, hashedNs, sortedFoldNs, hashedFoldNs);
+}
+
+int main() {
+    run<8>();
+    run<64>();
+    run<1024>();
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file bench_switch.cpp
+ * @brief Measures SwitchOn and EnumDispatcher against a native switch and the std::function builder.
+ *
+ * The baseline re-creates the previous builder, whose Then() and Default()
+ * took `const std::function<void()>&` and so built a std::function for every
+ * case in the chain, matched or not.
+ */
+
+#include <SmartEnumCpp/SmartEnum.hpp>
+#include <SmartEnumCpp/SmartEnumSwitch.hpp>
+#include <SmartEnumCpp/EnumDispatcher.hpp>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Opcode : public SmartEnum<Opcode> {
+public:
+    static const Opcode Load;
+    static const Opcode Store;
+    static const Opcode Add;
+    static const Opcode Sub;
+    static const Opcode Jump;
+    static const Opcode Halt;
+
+private:
+    Opcode(const std::string& name, int value) : SmartEnum(name, value) {}
+};
+const Opcode Opcode::Load("Load", 0);
+const Opcode Opcode::Store("Store", 1);
+const Opcode Opcode::Add("Add", 2);
+const Opcode Opcode::Sub("Sub", 3);
+const Opcode Opcode::Jump("Jump", 4);
+const Opcode Opcode::Halt("Halt", 5);
+
+// The builder as it was before actions became template parameters.
+class FunctionSwitch {
+public:
+    explicit FunctionSwitch(const Opcode& value) : value_(value), handled_(false), lastMatch_(false) {}
+
+    FunctionSwitch& When(const Opcode& candidate) {
+        lastMatch_ = !handled_ && value_ == candidate;
+        return *this;
+    }
+
+    FunctionSwitch& Then(const std::function<void()>& action) {
+        if (!handled_ && lastMatch_) {
+            action();
+            handled_ = true;
+        }
+        lastMatch_ = false;
+        return *this;
+    }
+
+    void Default(const std::function<void()>& action) {
+        if (!handled_) {
+            action();
+        }
+    }
+
+private:
+    const Opcode& value_;
+    bool handled_;
+    bool lastMatch_;
+};
+
+static long baseline(const Opcode& op, long acc) {
+    FunctionSwitch(op)
+        .When(Opcode::Load).Then([&] { acc += 1; })
+        .When(Opcode::Store).Then([&] { acc ^= 3; })
+        .When(Opcode::Add).Then([&] { acc += 7; })
+        .When(Opcode::Sub).Then([&] { acc -= 5; })
+        .When(Opcode::Jump).Then([&] { acc *= 3; })
+        .Default([&] { acc = 0; });
+    return acc;
+}
+
+static long fluent(const Opcode& op, long acc) {
+    SwitchOn(op)
+        .When(Opcode::Load).Then([&] { acc += 1; })
+        .When(Opcode::Store).Then([&] { acc ^= 3; })
+        .When(Opcode::Add).Then([&] { acc += 7; })
+        .When(Opcode::Sub).Then([&] { acc -= 5; })
+        .When(Opcode::Jump).Then([&] { acc *= 3; })
+        .Default([&] { acc = 0; });
+    return acc;
+}
+
+static long native(const Opcode& op, long acc) {
+    switch (op.Value()) {
+    case 0: acc += 1; break;
+    case 1: acc ^= 3; break;
+    case 2: acc += 7; break;
+    case 3: acc -= 5; break;
+    case 4: acc *= 3; break;
+    default: acc = 0; break;
+    }
+    return acc;
+}
+
+static const auto& prebuilt() {
+    static const auto dispatcher = EnumDispatcher<Opcode, long(long)>()
+        .On(Opcode::Load, [](long acc) { return acc + 1; })
+        .On(Opcode::Store, [](long acc) { return acc ^ 3; })
+        .On(Opcode::Add, [](long acc) { return acc + 7; })
+        .On(Opcode::Sub, [](long acc) { return acc - 5; })
+        .On(Opcode::Jump, [](long acc) { return acc * 3; })
+        .Default([](long) { return 0L; });
+    return dispatcher;
+}
+
+static long dispatched(const Opcode& op, long acc) {
+    return prebuilt()(op, acc);
+}
+
+template <typename TDispatch>
+static double measure(TDispatch dispatch, const std::vector<const Opcode*>& program, int rounds, long& sink) {
+    auto start = std::chrono::steady_clock::now();
+    long acc = 1;
+    for (int r = 0; r < rounds; ++r) {
+        for (const Opcode* op : program) {
+            acc = dispatch(*op, acc) & 0xffff;
+        }
+    }
+    sink += acc;
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(rounds) * program.size());
+}
+
+int main() {
+    std::vector<const Opcode*> program;
+    for (unsigned i = 0; i < 4096; ++i) {
+        program.push_back(Opcode::List()[((i * 2654435761u) >> 16) % Opcode::Count()]);
+    }
+
+    const int rounds = 500;
+    long sink = 0;
+    const double functionNs = measure(baseline, program, rounds, sink);
+    const double fluentNs = measure(fluent, program, rounds, sink);
+    const double dispatcherNs = measure(dispatched, program, rounds, sink);
+    const double nativeNs = measure(native, program, rounds, sink);
+    std::printf("std::function chain %5.2f ns  SwitchOn %5.2f ns  EnumDispatcher %5.2f ns  native switch %5.2f ns"
+                "  (sink %ld)\n",
+                functionNs, fluentNs, dispatcherNs, nativeNs, sink);
+    return 0;
+}
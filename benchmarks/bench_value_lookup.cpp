@@ -0,0 +1,88 @@
+/**
+ * @file bench_value_lookup.cpp
+ * @brief Compares SmartEnum::TryFromValue against an equivalent std::map lookup.
+ *
+ * PacketType has a contiguous value range and is served from the dense value
+ * table; SparseCode spreads its values too far apart for it and is served from
+ * the open-addressed value hash instead.
+ */
+
+#include <SmartEnumCpp/SmartEnum.hpp>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+class PacketType : public SmartEnum<PacketType> {
+public:
+    static const std::vector<const PacketType*>& Define(int count) {
+        for (int i = 0; i < count; ++i) {
+            new PacketType("Packet" + std::to_string(i), i);
+        }
+        return List();
+    }
+
+private:
+    PacketType(const std::string& name, int value) : SmartEnum(name, value) {}
+};
+
+class SparseCode : public SmartEnum<SparseCode> {
+public:
+    static const std::vector<const SparseCode*>& Define(int count) {
+        for (int i = 0; i < count; ++i) {
+            new SparseCode("Code" + std::to_string(i), i * 1000);
+        }
+        return List();
+    }
+
+private:
+    SparseCode(const std::string& name, int value) : SmartEnum(name, value) {}
+};
+
+template <typename TEnum>
+static void run(const char* label, int count, int stride) {
+    const auto& instances = TEnum::Define(count);
+
+    std::map<int, const TEnum*> baseline;
+    for (const TEnum* instance : instances) {
+        baseline[instance->Value()] = instance;
+    }
+
+    // Mix hits and misses the way a packet decoder sees them.
+    std::vector<int> inputs;
+    for (int i = 0; i < 4096; ++i) {
+        inputs.push_back(((i * 7919) % (count + count / 8 + 1)) * stride);
+    }
+
+    const int rounds = 2000;
+    std::size_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int value : inputs) {
+            auto it = baseline.find(value);
+            sink += it != baseline.end() ? 1 : 0;
+        }
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int value : inputs) {
+            const TEnum* found = nullptr;
+            sink += TEnum::TryFromValue(value, found) ? 1 : 0;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    const double lookups = static_cast<double>(rounds) * inputs.size();
+    const double mapNs = std::chrono::duration<double, std::nano>(mid - start).count() / lookups;
+    const double enumNs = std::chrono::duration<double, std::nano>(end - mid).count() / lookups;
+    std::printf("%-8s %5d values  std::map %6.2f ns  TryFromValue %6.2f ns  (sink %zu)\n",
+                label, count, mapNs, enumNs, sink);
+}
+
+int main() {
+    run<PacketType>("dense", 256, 1);
+    run<SparseCode>("sparse", 256, 1000);
+    return 0;
+}
@@ -0,0 +1,69 @@
+#!/bin/sh
+# Assembly check for SwitchOn: compiles a small dispatch function at -O2 and
+# fails if std::function machinery or any call survives in its body, i.e. if
+# the When/Then chain did not inline into plain compares and branches.
+#
+#   sh benchmarks/check_switch_asm.sh            (from the repository root)
+#   CXX=clang++ sh benchmarks/check_switch_asm.sh
+
+set -eu
+
+CXX=${CXX:-g++}
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+cat > "$WORK/probe.cpp" <<'CPP'
+#include <SmartEnumCpp/SmartEnum.hpp>
+#include <SmartEnumCpp/SmartEnumSwitch.hpp>
+
+class Opcode : public SmartEnum<Opcode> {
+public:
+    static const Opcode Load;
+    static const Opcode Store;
+    static const Opcode Add;
+    static const Opcode Halt;
+
+private:
+    Opcode(const std::string& name, int value) : SmartEnum(name, value) {}
+};
+const Opcode Opcode::Load("Load", 0);
+const Opcode Opcode::Store("Store", 1);
+const Opcode Opcode::Add("Add", 2);
+const Opcode Opcode::Halt("Halt", 3);
+
+extern "C" long switch_probe(const Opcode& op, long acc) {
+    SwitchOn(op)
+        .When(Opcode::Load).Then([&] { acc += 1; })
+        .When(Opcode::Store).Then([&] { acc ^= 3; })
+        .When(Opcode::Add).Then([&] { acc += 7; })
+        .Default([&] { acc = 0; });
+    return acc;
+}
+CPP
+
+"$CXX" -std=c++17 -O2 -S -fno-asynchronous-unwind-tables -I"$ROOT/include" "$WORK/probe.cpp" -o "$WORK/probe.s"
+
+# Body of switch_probe: from its label to the end-of-function marker.
+sed -n '/^switch_probe:/,/\.size[[:space:]]*switch_probe/p' "$WORK/probe.s" > "$WORK/body.s"
+
+if [ ! -s "$WORK/body.s" ]; then
+    echo "FAIL: switch_probe not found in the generated assembly" >&2
+    exit 1
+fi
+
+status=0
+if grep -E '_Function_base|_M_manager|bad_function_call' "$WORK/probe.s" > /dev/null; then
+    echo "FAIL: std::function code generated for SwitchOn" >&2
+    status=1
+fi
+if grep -E '^[[:space:]]*(call|bl|jmp[[:space:]]+_Z)' "$WORK/body.s" > /dev/null; then
+    echo "FAIL: switch_probe still calls out:" >&2
+    grep -E '^[[:space:]]*(call|bl|jmp[[:space:]]+_Z)' "$WORK/body.s" >&2
+    status=1
+fi
+
+if [ "$status" -eq 0 ]; then
+    echo "PASS: SwitchOn inlined to $(grep -cE '^[[:space:]]+[a-z]' "$WORK/body.s") instructions, no calls"
+fi
+exit "$status"
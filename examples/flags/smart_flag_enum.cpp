@@ -14,12 +14,12 @@ private:
     FilePermissions(const std::string& name, unsigned int value) : SmartFlagEnum(name, value) {}
 };
 
-// Initialize the flag values (must be powers of 2)
-const FilePermissions FilePermissions::None("None", 0);
-const FilePermissions FilePermissions::Read("Read", 1);      // 1 = 2^0
-const FilePermissions FilePermissions::Write("Write", 2);    // 2 = 2^1
-const FilePermissions FilePermissions::Execute("Execute", 4); // 4 = 2^2
-const FilePermissions FilePermissions::Delete("Delete", 8);  // 8 = 2^3
+// Initialize the flag values (must be powers of 2; Flag<> checks that at compile time)
+const FilePermissions FilePermissions::None("None", Flag<0>());
+const FilePermissions FilePermissions::Read("Read", Flag<1>());      // 1 = 2^0
+const FilePermissions FilePermissions::Write("Write", Flag<2>());    // 2 = 2^1
+const FilePermissions FilePermissions::Execute("Execute", Flag<4>()); // 4 = 2^2
+const FilePermissions FilePermissions::Delete("Delete", Flag<8>());  // 8 = 2^3
 
 // Helper function to print permissions
 void printPermissions(unsigned int permValue) {
@@ -93,8 +93,11 @@ int main() {
      * 1. To allow negative values (like -1 for "All"):
      *    class MyFlags : public SmartFlagEnum<MyFlags>, public AllowNegativeFlagEnumInput {...};
      *
-     * 2. To allow non-power-of-two values:
+     * 2. To allow non-power-of-two values in Flag<>():
      *    class MyFlags : public SmartFlagEnum<MyFlags>, public AllowUnsafeFlagEnumValues {...};
+     *
+     * Both markers are detected at compile time. Without the first, defining a
+     * negative flag throws NegativeFlagValueNotAllowedException at registration.
      */
     
     return 0;
@@ -0,0 +1,70 @@
+// Build with exceptions and RTTI disabled, e.g.:
+//   g++ -std=c++17 -fno-exceptions -fno-rtti -Iinclude no_exceptions_smart_enum.cpp
+// The library detects both switches; SMARTENUM_NO_EXCEPTIONS and
+// SMARTENUM_NO_RTTI can also be defined explicitly.
+#include <SmartEnumCpp/SmartEnum.hpp>
+#include <SmartEnumCpp/SmartFlagEnum.hpp>
+#include <iostream>
+
+class Command : public SmartEnum<Command> {
+public:
+    static const Command Start;
+    static const Command Stop;
+    static const Command Reset;
+
+private:
+    Command(const std::string& name, int value) : SmartEnum(name, value) {}
+};
+
+const Command Command::Start("Start", 1);
+const Command Command::Stop("Stop", 2);
+const Command Command::Reset("Reset", 3);
+
+class Permission : public SmartFlagEnum<Permission> {
+public:
+    static const Permission Read;
+    static const Permission Write;
+    static const Permission Execute;
+
+private:
+    Permission(const std::string& name, int value) : SmartFlagEnum(name, value) {}
+};
+
+const Permission Permission::Read("Read", 1);
+const Permission Permission::Write("Write", 2);
+const Permission Permission::Execute("Execute", 4);
+
+int main() {
+    // Input as it might arrive over a serial line or socket
+    const char* tokens[] = {"start", "STOP", "launch"};
+
+    for (const char* token : tokens) {
+        auto command = Command::FindName(token, true);
+        if (command) {
+            std::cout << token << " -> " << command->Name() << " (" << command->Value() << ")" << std::endl;
+        } else {
+            std::cout << token << " -> error: " << ToString(command.Error()) << std::endl;
+        }
+    }
+
+    // Fall back to a default instead of branching
+    const Command& fallback = Command::FindValue(42).ValueOr(Command::Reset);
+    std::cout << "Value 42 falls back to " << fallback.Name() << std::endl;
+
+    // Flag lookups report why they failed
+    for (int value : {3, 8, -1}) {
+        auto names = Permission::FindValueToString(value);
+        if (names) {
+            std::cout << value << " -> " << *names << std::endl;
+        } else {
+            std::cout << value << " -> error: " << ToString(names.Error()) << std::endl;
+        }
+    }
+
+    auto parsed = Permission::FindName("Read, Execute");
+    if (parsed) {
+        std::cout << "Parsed " << parsed->size() << " permissions" << std::endl;
+    }
+
+    return 0;
+}
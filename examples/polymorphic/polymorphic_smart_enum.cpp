@@ -1,4 +1,5 @@
 #include <SmartEnumCpp/SmartEnum.hpp>
+#include <SmartEnumCpp/EnumMap.hpp>
 #include <iostream>
 #include <iomanip>
 
@@ -117,6 +118,18 @@ int main() {
     if (selectedMethod.GetProcessingDays() > 3) {
         std::cout << "Warning: This payment method takes longer than 3 days to process." << std::endl;
     }
+
+    // Keep per-method totals in an EnumMap, indexed directly by the instance
+    EnumMap<PaymentMethod, float> feesCollected;
+    for (float amount : {25.0f, 80.0f, 140.0f}) {
+        feesCollected[PaymentMethod::CreditCard] += PaymentMethod::CreditCard.CalculateProcessingFee(amount);
+        feesCollected[PaymentMethod::Check] += PaymentMethod::Check.CalculateProcessingFee(amount);
+    }
+
+    std::cout << "\nFees collected per payment method:" << std::endl;
+    for (auto [method, fees] : feesCollected) {
+        std::cout << "  " << std::left << std::setw(12) << method.Name() << "$" << fees << std::endl;
+    }
     
     return 0;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <SmartEnumCpp/SmartEnum.hpp>
 #include <SmartEnumCpp/SmartEnumSwitch.hpp>
+#include <SmartEnumCpp/EnumDispatcher.hpp>
 #include <iostream>
 #include <string>
 
@@ -28,86 +29,67 @@ const OrderStatus OrderStatus::Canceled("Canceled", 6);
 // A class representing an order
 class Order {
 public:
-    Order(int id, const OrderStatus& status) : id_(id), status_(status) {}
+    Order(int id, const OrderStatus& status) : id_(id), status_(&status) {}
     
     int GetId() const { return id_; }
-    const OrderStatus& GetStatus() const { return status_; }
-    void SetStatus(const OrderStatus& status) { status_ = status; }
+    const OrderStatus& GetStatus() const { return *status_; }
+    void SetStatus(const OrderStatus& status) { status_ = &status; }
     
     // Process the order based on its status
     void Process() {
-        std::cout << "Processing Order #" << id_ << " (Status: " << status_.Name() << ")..." << std::endl;
+        std::cout << "Processing Order #" << id_ << " (Status: " << status_->Name() << ")..." << std::endl;
         
-        // Using the fluent switch interface
-        SwitchOn(status_)
-            .When(OrderStatus::Created).Then([this]() {
+        // The handler table is built once and reused by every call
+        static const auto process = EnumDispatcher<OrderStatus, void(Order&)>()
+            .On(OrderStatus::Created, [](Order&) {
                 std::cout << " - New order created, awaiting payment" << std::endl;
                 std::cout << " - Sending confirmation email to customer" << std::endl;
             })
-            .When(OrderStatus::Paid).Then([this]() {
+            .On(OrderStatus::Paid, [](Order& order) {
                 std::cout << " - Payment received, preparing to fulfill order" << std::endl;
                 std::cout << " - Moving to processing queue" << std::endl;
-                this->SetStatus(OrderStatus::Processing);
+                order.SetStatus(OrderStatus::Processing);
             })
-            .When(OrderStatus::Processing).Then([this]() {
+            .On(OrderStatus::Processing, [](Order& order) {
                 std::cout << " - Picking items from warehouse" << std::endl;
                 std::cout << " - Packaging items" << std::endl;
                 std::cout << " - Order ready for shipping" << std::endl;
-                this->SetStatus(OrderStatus::Shipped);
+                order.SetStatus(OrderStatus::Shipped);
             })
-            .When(OrderStatus::Shipped).Then([this]() {
+            .On(OrderStatus::Shipped, [](Order&) {
                 std::cout << " - Order has been shipped" << std::endl;
                 std::cout << " - Tracking information sent to customer" << std::endl;
             })
-            .When(OrderStatus::Delivered).Then([this]() {
+            .On(OrderStatus::Delivered, [](Order&) {
                 std::cout << " - Order successfully delivered" << std::endl;
                 std::cout << " - Requesting customer feedback" << std::endl;
             })
-            .When(OrderStatus::Canceled).Then([this]() {
+            .On(OrderStatus::Canceled, [](Order&) {
                 std::cout << " - Order was canceled" << std::endl;
                 std::cout << " - Processing refund if applicable" << std::endl;
             })
-            .Default([]() {
-                std::cout << " - Unknown status, review required" << std::endl;
-            });
+            .Exhaustive();
+
+        process(*status_, *this);
             
-        std::cout << "Processing complete. Current status: " << status_.Name() << std::endl << std::endl;
+        std::cout << "Processing complete. Current status: " << status_->Name() << std::endl << std::endl;
     }
     
 private:
     int id_;
-    OrderStatus status_;
+    const OrderStatus* status_;
 };
 
-// Function demonstrating the use of SwitchOn with a return value
+// Function demonstrating the use of Match to return a value
 std::string GetOrderStatusDescription(const OrderStatus& status) {
-    std::string result;
-    
-    // Build a string description based on status
-    SwitchOn(status)
-        .When(OrderStatus::Created).Then([&result]() {
-            result = "Order has been created but not yet paid";
-        })
-        .When(OrderStatus::Paid).Then([&result]() {
-            result = "Payment received, awaiting processing";
-        })
-        .When(OrderStatus::Processing).Then([&result]() {
-            result = "Order is being prepared for shipping";
-        })
-        .When(OrderStatus::Shipped).Then([&result]() {
-            result = "Order has been shipped and is in transit";
-        })
-        .When(OrderStatus::Delivered).Then([&result]() {
-            result = "Order has been successfully delivered";
-        })
-        .When(OrderStatus::Canceled).Then([&result]() {
-            result = "Order was canceled";
-        })
-        .Default([&result]() {
-            result = "Unknown order status";
-        });
-    
-    return result;
+    return Match<std::string>(status)
+        .When(OrderStatus::Created, [] { return "Order has been created but not yet paid"; })
+        .When(OrderStatus::Paid, [] { return "Payment received, awaiting processing"; })
+        .When(OrderStatus::Processing, [] { return "Order is being prepared for shipping"; })
+        .When(OrderStatus::Shipped, [] { return "Order has been shipped and is in transit"; })
+        .When(OrderStatus::Delivered, [] { return "Order has been successfully delivered"; })
+        .When(OrderStatus::Canceled, [] { return "Order was canceled"; })
+        .Otherwise([] { return "Unknown order status"; });
 }
 
 // Function showing how to use SwitchOn with conditional logic
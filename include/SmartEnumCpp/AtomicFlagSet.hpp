@@ -0,0 +1,248 @@
+/**
+ * @file AtomicFlagSet.hpp
+ * @brief Lock-free FlagSet for flag state shared between threads.
+ *
+ * An AtomicFlagSet wraps a std::atomic of the flag enum's value type. Every
+ * mutation is a single atomic read-modify-write on that value and takes an
+ * explicit memory order. Threads can wait until a flag is raised: with C++20
+ * atomic waiting they block, otherwise they poll and yield.
+ *
+ * Example:
+ * @code
+ * AtomicFlagSet<ConnectionState> state;
+ *
+ * // writer
+ * state.Set(ConnectionState::Handshaken, std::memory_order_release);
+ * state.NotifyAll();
+ *
+ * // reader
+ * state.WaitFor(ConnectionState::Handshaken);
+ * @endcode
+ */
+
+#ifndef ATOMICFLAGSET_HPP
+#define ATOMICFLAGSET_HPP
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+
+#include "FlagSet.hpp"
+
+// Without std::atomic::wait (before C++20), waiting polls and notifying does nothing
+#if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+#define SMARTENUM_HAS_ATOMIC_WAIT
+#endif
+
+/**
+ * @brief Atomic set of flags of TEnum.
+ *
+ * Mutators return the flags as they were just before the operation. They do
+ * not notify waiters; call NotifyOne() or NotifyAll() after raising a flag
+ * that another thread may be waiting for.
+ *
+ * @tparam TEnum The SmartFlagEnum type (integral value type).
+ */
+template <typename TEnum>
+class AtomicFlagSet
+{
+public:
+    using ValueType = typename TEnum::ValueType;
+    using Flags = FlagSet<TEnum>;
+
+    static_assert(std::atomic<ValueType>::is_always_lock_free, "AtomicFlagSet needs a lock-free value type");
+
+    /**
+     * @brief Creates an empty set.
+     */
+    constexpr AtomicFlagSet() noexcept : value_(0) {}
+
+    /**
+     * @brief Creates a set holding @p flags.
+     */
+    constexpr explicit AtomicFlagSet(Flags flags) noexcept : value_(flags.Value()) {}
+
+    AtomicFlagSet(const AtomicFlagSet &) = delete;
+    AtomicFlagSet &operator=(const AtomicFlagSet &) = delete;
+
+    /**
+     * @brief Reads the current flags.
+     */
+    Flags Load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        return Flags(value_.load(order));
+    }
+
+    /**
+     * @brief Replaces the current flags.
+     */
+    void Store(Flags flags, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        value_.store(flags.Value(), order);
+    }
+
+    /**
+     * @brief Replaces the current flags and returns the previous ones.
+     */
+    Flags Exchange(Flags flags, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return Flags(value_.exchange(flags.Value(), order));
+    }
+
+    /**
+     * @brief True if every bit of @p flags is set.
+     */
+    bool Test(Flags flags, std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        return Load(order).HasAll(flags);
+    }
+
+    /**
+     * @brief Raises every bit of @p flags.
+     */
+    Flags Set(Flags flags, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return Flags(value_.fetch_or(flags.Value(), order));
+    }
+
+    /**
+     * @brief Lowers every bit of @p flags.
+     */
+    Flags Clear(Flags flags, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return Flags(value_.fetch_and(static_cast<ValueType>(~flags.Value()), order));
+    }
+
+    /**
+     * @brief Flips every bit of @p flags.
+     */
+    Flags Toggle(Flags flags, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return Flags(value_.fetch_xor(flags.Value(), order));
+    }
+
+    /**
+     * @brief Raises @p flags and reports whether they were all set already.
+     *
+     * Exactly one of several threads racing to raise the same flag sees false.
+     */
+    bool TestAndSet(Flags flags, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return Set(flags, order).HasAll(flags);
+    }
+
+    /**
+     * @brief Replaces the flags with @p desired if they equal @p expected.
+     *
+     * On failure @p expected receives the current flags.
+     */
+    bool CompareExchange(Flags &expected, Flags desired, std::memory_order success,
+                         std::memory_order failure) noexcept
+    {
+        ValueType raw = expected.Value();
+        const bool exchanged = value_.compare_exchange_strong(raw, desired.Value(), success, failure);
+        expected = Flags(raw);
+        return exchanged;
+    }
+
+    bool CompareExchange(Flags &expected, Flags desired,
+                         std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        ValueType raw = expected.Value();
+        const bool exchanged = value_.compare_exchange_strong(raw, desired.Value(), order);
+        expected = Flags(raw);
+        return exchanged;
+    }
+
+    /**
+     * @brief Like CompareExchange() but may fail spuriously; use inside a retry loop.
+     */
+    bool CompareExchangeWeak(Flags &expected, Flags desired, std::memory_order success,
+                             std::memory_order failure) noexcept
+    {
+        ValueType raw = expected.Value();
+        const bool exchanged = value_.compare_exchange_weak(raw, desired.Value(), success, failure);
+        expected = Flags(raw);
+        return exchanged;
+    }
+
+    bool CompareExchangeWeak(Flags &expected, Flags desired,
+                             std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        ValueType raw = expected.Value();
+        const bool exchanged = value_.compare_exchange_weak(raw, desired.Value(), order);
+        expected = Flags(raw);
+        return exchanged;
+    }
+
+    /**
+     * @brief True if operations never take a lock (always, see the static_assert).
+     */
+    static constexpr bool IsAlwaysLockFree() { return std::atomic<ValueType>::is_always_lock_free; }
+
+    /**
+     * @brief Blocks while the flags equal @p old.
+     *
+     * Uses std::atomic::wait where the library has it (C++20); otherwise
+     * polls the value, yielding the thread between reads.
+     */
+    void Wait(Flags old, std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        waitWhile(old.Value(), order);
+    }
+
+    /**
+     * @brief Blocks until every bit of @p flags is set and returns the flags seen then.
+     */
+    Flags WaitFor(Flags flags, std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        ValueType current = value_.load(order);
+        while ((current & flags.Value()) != flags.Value())
+        {
+            waitWhile(current, order);
+            current = value_.load(order);
+        }
+        return Flags(current);
+    }
+
+    /**
+     * @brief Wakes one thread blocked in Wait() or WaitFor().
+     *
+     * Without std::atomic::wait, waiters poll and this does nothing.
+     */
+    void NotifyOne() noexcept
+    {
+#ifdef SMARTENUM_HAS_ATOMIC_WAIT
+        value_.notify_one();
+#endif
+    }
+
+    /**
+     * @brief Wakes every thread blocked in Wait() or WaitFor().
+     *
+     * Without std::atomic::wait, waiters poll and this does nothing.
+     */
+    void NotifyAll() noexcept
+    {
+#ifdef SMARTENUM_HAS_ATOMIC_WAIT
+        value_.notify_all();
+#endif
+    }
+
+private:
+    void waitWhile(ValueType old, std::memory_order order) const noexcept
+    {
+#ifdef SMARTENUM_HAS_ATOMIC_WAIT
+        value_.wait(old, order);
+#else
+        while (value_.load(order) == old)
+        {
+            std::this_thread::yield();
+        }
+#endif
+    }
+
+    std::atomic<ValueType> value_;
+};
+
+#endif // ATOMICFLAGSET_HPP
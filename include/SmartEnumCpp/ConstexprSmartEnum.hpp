@@ -0,0 +1,367 @@
+/**
+ * @file ConstexprSmartEnum.hpp
+ * @brief SmartEnum variant whose instances and lookup tables are built at compile time.
+ *
+ * A ConstexprSmartEnum declares its instances as one constexpr std::array
+ * named Definitions. Names are string literals and values are literal types,
+ * so the instances, List() and the sorted name and value indexes are all
+ * constant-initialized: nothing runs at static-initialization time, nothing
+ * allocates, and the tables end up in read-only data.
+ *
+ * Example:
+ * @code
+ * class Color : public ConstexprSmartEnum<Color> {
+ * public:
+ *     static const std::array<Color, 3> Definitions;
+ *     static const Color& Red;
+ *     static const Color& Green;
+ *     static const Color& Blue;
+ * private:
+ *     constexpr Color(std::string_view name, int value) : ConstexprSmartEnum(name, value) {}
+ * };
+ *
+ * constexpr std::array<Color, 3> Color::Definitions = {
+ *     Color("Red", 1),
+ *     Color("Green", 2),
+ *     Color("Blue", 3),
+ * };
+ * constexpr const Color& Color::Red = Color::Definitions[0];
+ * constexpr const Color& Color::Green = Color::Definitions[1];
+ * constexpr const Color& Color::Blue = Color::Definitions[2];
+ *
+ * static_assert(Color::FromName("Green").Value() == 2, "resolved at compile time");
+ * @endcode
+ *
+ * List(), FromName(), TryFromName(), FindName(), FromValue(), TryFromValue()
+ * and FindValue() behave as they do for SmartEnum, and are usable in constant expressions. Name()
+ * returns a std::string_view instead of a std::string reference. Declaring
+ * the same name twice is a compile error as soon as any lookup is used.
+ */
+
+#ifndef CONSTEXPRSMARTENUM_HPP
+#define CONSTEXPRSMARTENUM_HPP
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "SmartEnum.hpp"
+#include "detail/AsciiCase.hpp"
+
+namespace SmartEnumDetail {
+
+/**
+ * @brief Reached only when two ConstexprSmartEnum instances share a name.
+ *
+ * Not constexpr on purpose: in a constant expression the call itself is the
+ * compile error, and its name explains it.
+ */
+inline void constexprSmartEnumDuplicateName() {
+    Raise<std::invalid_argument>([] { return "ConstexprSmartEnum names must be unique"; });
+}
+
+/**
+ * @brief Compile-time lookup tables of a ConstexprSmartEnum.
+ *
+ * The name and value indexes are sorted by insertion sort, which is stable,
+ * so among case-insensitively equal names and among duplicate values the
+ * earliest definition wins, matching SmartEnum.
+ */
+template <typename TEnum>
+struct ConstexprEnumTables {
+    using ValueType = typename TEnum::ValueType;
+    static constexpr std::size_t kCount =
+        std::tuple_size<std::remove_cv_t<decltype(TEnum::Definitions)>>::value;
+
+    struct NameEntry {
+        std::string_view name;
+        std::size_t ordinal;
+    };
+
+    struct ValueEntry {
+        ValueType value;
+        std::size_t ordinal;
+    };
+
+    std::array<const TEnum*, kCount> instances{};
+    std::array<NameEntry, kCount> byName{};
+    std::array<NameEntry, kCount> byNameIgnoreCase{};
+    std::array<ValueEntry, kCount> byValue{};
+
+    constexpr ConstexprEnumTables() {
+        for (std::size_t i = 0; i < kCount; ++i) {
+            const TEnum& instance = TEnum::Definitions[i];
+            instances[i] = &instance;
+            byName[i] = NameEntry{instance.Name(), i};
+            byNameIgnoreCase[i] = NameEntry{instance.Name(), i};
+            byValue[i] = ValueEntry{instance.Value(), i};
+        }
+        insertionSort(byName, [](const NameEntry& a, const NameEntry& b) { return a.name < b.name; });
+        insertionSort(byNameIgnoreCase, [](const NameEntry& a, const NameEntry& b) {
+            return CompareIgnoreCase(a.name, b.name) < 0;
+        });
+        insertionSort(byValue, [](const ValueEntry& a, const ValueEntry& b) { return a.value < b.value; });
+        for (std::size_t i = 1; i < kCount; ++i) {
+            if (byName[i - 1].name == byName[i].name) {
+                constexprSmartEnumDuplicateName();
+            }
+        }
+    }
+
+    constexpr const TEnum* FindName(std::string_view name) const {
+        const std::size_t i = lowerBound(byName, [name](const NameEntry& e) { return e.name < name; });
+        return i < kCount && byName[i].name == name ? instances[byName[i].ordinal] : nullptr;
+    }
+
+    constexpr const TEnum* FindNameIgnoreCase(std::string_view name) const {
+        const std::size_t i = lowerBound(byNameIgnoreCase, [name](const NameEntry& e) {
+            return CompareIgnoreCase(e.name, name) < 0;
+        });
+        return i < kCount && EqualsIgnoreCase(byNameIgnoreCase[i].name, name)
+            ? instances[byNameIgnoreCase[i].ordinal] : nullptr;
+    }
+
+    constexpr const TEnum* FindValue(const ValueType& value) const {
+        const std::size_t i = lowerBound(byValue, [&value](const ValueEntry& e) { return e.value < value; });
+        return i < kCount && !(value < byValue[i].value) ? instances[byValue[i].ordinal] : nullptr;
+    }
+
+private:
+    template <typename TEntry, typename TLess>
+    static constexpr void insertionSort(std::array<TEntry, kCount>& entries, TLess less) {
+        for (std::size_t i = 1; i < kCount; ++i) {
+            TEntry entry = entries[i];
+            std::size_t j = i;
+            for (; j > 0 && less(entry, entries[j - 1]); --j) {
+                entries[j] = entries[j - 1];
+            }
+            entries[j] = entry;
+        }
+    }
+
+    template <typename TEntry, typename TBelow>
+    static constexpr std::size_t lowerBound(const std::array<TEntry, kCount>& entries, TBelow below) {
+        std::size_t first = 0;
+        std::size_t count = kCount;
+        while (count > 0) {
+            const std::size_t half = count / 2;
+            if (below(entries[first + half])) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first;
+    }
+};
+
+template <typename TEnum>
+inline constexpr ConstexprEnumTables<TEnum> constexprEnumTables{};
+
+} // namespace SmartEnumDetail
+
+/**
+ * @brief Template base class for SmartEnum types defined entirely at compile time.
+ *
+ * The derived type must provide `static const std::array<TEnum, N> Definitions`
+ * defined as constexpr; an instance's Ordinal() is its index in that array.
+ *
+ * @tparam TEnum The derived enum type.
+ * @tparam TValue The underlying value type (default is int); must be a literal type.
+ */
+template <typename TEnum, typename TValue = int>
+class ConstexprSmartEnum {
+public:
+    using ValueType = TValue;
+    using EnumType = TEnum;
+
+    // Instances are only ever the elements of Definitions, which Ordinal() relies on
+    ConstexprSmartEnum(const ConstexprSmartEnum&) = delete;
+    ConstexprSmartEnum& operator=(const ConstexprSmartEnum&) = delete;
+
+    /**
+     * @brief Gets the name of the enum instance.
+     */
+    constexpr std::string_view Name() const { return name_; }
+
+    /**
+     * @brief Gets the underlying value of the enum instance.
+     */
+    constexpr const ValueType& Value() const { return value_; }
+
+    /**
+     * @brief Gets the zero-based position of the enum instance in Definitions.
+     */
+    constexpr std::size_t Ordinal() const {
+        return static_cast<std::size_t>(static_cast<const TEnum*>(this) - TEnum::Definitions.data());
+    }
+
+    /**
+     * @brief Equality operator compares underlying values.
+     */
+    constexpr bool operator==(const ConstexprSmartEnum& other) const { return value_ == other.value_; }
+    constexpr bool operator!=(const ConstexprSmartEnum& other) const { return !(*this == other); }
+
+    /**
+     * @brief Implicit conversion to the underlying value type.
+     */
+    constexpr operator TValue () const { return value_; }
+
+    /**
+     * @brief Compares equality based on the underlying value.
+     */
+    constexpr bool Equals(const TEnum& other) const { return value_ == other.Value(); }
+
+    /**
+     * @brief Returns the string representation (the name).
+     */
+    std::string ToString() const { return std::string(name_); }
+    operator std::string() const { return ToString(); }
+
+    /**
+     * @brief Returns all enum instances in definition order.
+     */
+    static constexpr const auto& List() { return tables().instances; }
+
+    /**
+     * @brief Returns the number of defined enum instances.
+     */
+    static constexpr std::size_t Count() { return Tables::kCount; }
+
+    /**
+     * @brief Returns an enum instance by name.
+     *
+     * @param name The name of the enum instance.
+     * @param ignoreCase If true, perform an ASCII case-insensitive search.
+     * @return The matching enum instance.
+     * @throws SmartEnumNotFoundException if not found.
+     */
+    static constexpr const TEnum& FromName(std::string_view name, bool ignoreCase = false) {
+        const TEnum* result = nullptr;
+        if (!TryFromName(name, result, ignoreCase)) {
+            SmartEnumDetail::Raise<SmartEnumNotFoundException>([&] {
+                return "No " + std::string(SmartEnumDetail::TypeName<TEnum>()) +
+                       " with name \"" + std::string(name) + "\" found";
+            });
+        }
+        return *result;
+    }
+
+    /**
+     * @brief Returns an enum instance by a name given as pointer and length.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static constexpr const TEnum& FromName(const char* name, TSize length, bool ignoreCase = false) {
+        return FromName(std::string_view(name, static_cast<std::size_t>(length)), ignoreCase);
+    }
+
+    /**
+     * @brief Tries to get an enum instance by name.
+     *
+     * @param name The name to search.
+     * @param outResult Pointer to the found enum instance.
+     * @param ignoreCase If true, perform an ASCII case-insensitive search.
+     * @return true if found; false otherwise.
+     */
+    static constexpr bool TryFromName(std::string_view name, const TEnum*& outResult, bool ignoreCase = false) {
+        outResult = ignoreCase ? tables().FindNameIgnoreCase(name) : tables().FindName(name);
+        return outResult != nullptr;
+    }
+
+    /**
+     * @brief Tries to get an enum instance by a name given as pointer and length.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static constexpr bool TryFromName(const char* name, TSize length, const TEnum*& outResult,
+                                      bool ignoreCase = false) {
+        return TryFromName(std::string_view(name, static_cast<std::size_t>(length)), outResult, ignoreCase);
+    }
+
+    /**
+     * @brief Returns an enum instance by its underlying value.
+     *
+     * @param value The underlying value.
+     * @return The matching enum instance.
+     * @throws SmartEnumNotFoundException if not found.
+     */
+    static constexpr const TEnum& FromValue(const ValueType& value) {
+        const TEnum* result = nullptr;
+        if (!TryFromValue(value, result)) {
+            SmartEnumDetail::Raise<SmartEnumNotFoundException>([&] {
+                return "No " + std::string(SmartEnumDetail::TypeName<TEnum>()) +
+                       " with value \"" + std::to_string(static_cast<long long>(value)) + "\" found";
+            });
+        }
+        return *result;
+    }
+
+    /**
+     * @brief Tries to get an enum instance by its value.
+     *
+     * @param value The underlying value.
+     * @param outResult Pointer to the found enum instance.
+     * @return true if found; false otherwise.
+     */
+    static constexpr bool TryFromValue(const ValueType& value, const TEnum*& outResult) {
+        outResult = tables().FindValue(value);
+        return outResult != nullptr;
+    }
+
+    /**
+     * @brief Looks up an enum instance by name without throwing.
+     *
+     * @return The matching instance, or SmartEnumErrc::NameNotFound.
+     */
+    static constexpr SmartEnumResult<const TEnum&> FindName(std::string_view name, bool ignoreCase = false) {
+        const TEnum* result = ignoreCase ? tables().FindNameIgnoreCase(name) : tables().FindName(name);
+        return result ? SmartEnumResult<const TEnum&>(*result) : SmartEnumResult<const TEnum&>(SmartEnumErrc::NameNotFound);
+    }
+
+    /**
+     * @brief Looks up an enum instance by a name given as pointer and length, without throwing.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static constexpr SmartEnumResult<const TEnum&> FindName(const char* name, TSize length, bool ignoreCase = false) {
+        return FindName(std::string_view(name, static_cast<std::size_t>(length)), ignoreCase);
+    }
+
+    /**
+     * @brief Looks up an enum instance by value without throwing.
+     *
+     * @return The matching instance, or SmartEnumErrc::ValueNotFound.
+     */
+    static constexpr SmartEnumResult<const TEnum&> FindValue(const ValueType& value) {
+        const TEnum* result = tables().FindValue(value);
+        return result ? SmartEnumResult<const TEnum&>(*result) : SmartEnumResult<const TEnum&>(SmartEnumErrc::ValueNotFound);
+    }
+
+protected:
+    /**
+     * @brief Protected constexpr constructor; nothing is registered at runtime.
+     *
+     * @param name The unique name of the enum instance, usually a string literal.
+     * @param value The underlying value.
+     */
+    constexpr ConstexprSmartEnum(std::string_view name, const ValueType& value) : name_(name), value_(value) {
+        if (name.empty()) {
+            SmartEnumDetail::Raise<std::invalid_argument>([] { return "SmartEnum name cannot be empty"; });
+        }
+    }
+
+private:
+    using Tables = SmartEnumDetail::ConstexprEnumTables<TEnum>;
+
+    static constexpr const Tables& tables() { return SmartEnumDetail::constexprEnumTables<TEnum>; }
+
+    std::string_view name_;
+    ValueType value_;
+};
+
+#endif // CONSTEXPRSMARTENUM_HPP
@@ -0,0 +1,240 @@
+/**
+ * @file EnumDispatcher.hpp
+ * @brief Reusable handler table keyed by SmartEnum (or SmartFlagEnum) instances.
+ *
+ * An EnumDispatcher is built once from (instance, callable) pairs and then
+ * invoked any number of times. Handlers sit in a contiguous array indexed by
+ * the instance's Ordinal(), so a dispatch is one bounds check and one indirect
+ * call whatever the number of cases, with the call arguments forwarded.
+ *
+ * Example:
+ * @code
+ * const auto process = EnumDispatcher<OrderStatus, void(Order&)>()
+ *     .On(OrderStatus::Created, [](Order& order) { order.SendConfirmation(); })
+ *     .On(OrderStatus::Paid, [](Order& order) { order.SetStatus(OrderStatus::Processing); })
+ *     .Default([](Order&) {})
+ *     .Exhaustive();                         // throws if a status has no handler
+ *
+ * process(order.GetStatus(), order);        // O(1), same handlers every call
+ * @endcode
+ *
+ * Use SwitchOn for one-off branching; use an EnumDispatcher when the same
+ * handler set is applied repeatedly, e.g. in an event loop.
+ *
+ * ForEachFlag() runs a dispatcher over a SmartFlagEnum's handlers once per
+ * flag set in a combined value:
+ * @code
+ * ForEachFlag(peer.Capabilities(), onCapability, session);
+ * @endcode
+ */
+
+#ifndef ENUMDISPATCHER_HPP
+#define ENUMDISPATCHER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "detail/Config.hpp"
+
+template <typename TEnum, typename Signature>
+class EnumDispatcher;
+
+/**
+ * @brief Table of handlers with signature R(Args...), one slot per instance of TEnum.
+ *
+ * The table is sized to TEnum::Count() when the dispatcher is constructed.
+ * Handlers are stored once, when they are added, and are only ever invoked as
+ * const, so copies of a dispatcher can share them; a handler that mutates its
+ * own state (a mutable lambda) is rejected at compile time. Instances
+ * registered after construction fall through to the default handler.
+ *
+ * @tparam TEnum The SmartEnum or SmartFlagEnum type dispatched on.
+ * @tparam R The handlers' return type.
+ * @tparam Args The handlers' parameter types, forwarded on every call.
+ */
+template <typename TEnum, typename R, typename... Args>
+class EnumDispatcher<TEnum, R(Args...)> {
+public:
+    /**
+     * @brief Creates a dispatcher with no handlers.
+     */
+    EnumDispatcher() : slots_(TEnum::Count()), default_{} {}
+
+    /**
+     * @brief Handles @p instance with @p handler, replacing any previous handler for it.
+     * @throws std::out_of_range if @p instance was registered after the dispatcher was created.
+     */
+    template <typename THandler>
+    EnumDispatcher& On(const TEnum& instance, THandler&& handler) & {
+        const std::size_t index = instance.Ordinal();
+        if (index >= slots_.size()) {
+            SmartEnumDetail::Raise<std::out_of_range>([&instance] {
+                return "EnumDispatcher has no slot for " + std::string(instance.Name());
+            });
+        }
+        const Slot previous = slots_[index];
+        slots_[index] = store(std::forward<THandler>(handler));
+        release(previous.target);
+        return *this;
+    }
+
+    template <typename THandler>
+    EnumDispatcher&& On(const TEnum& instance, THandler&& handler) && {
+        return std::move(On(instance, std::forward<THandler>(handler)));
+    }
+
+    /**
+     * @brief Handles every instance that has no handler of its own with @p handler.
+     *
+     * Replaces, and releases, any earlier default handler.
+     */
+    template <typename THandler>
+    EnumDispatcher& Default(THandler&& handler) & {
+        const Slot previous = default_;
+        default_ = store(std::forward<THandler>(handler));
+
+        // Unhandled slots point at the default directly, so dispatch never checks for it
+        for (Slot& slot : slots_) {
+            if (!slot.invoke || slot.target == previous.target) {
+                slot = default_;
+            }
+        }
+        release(previous.target);
+        return *this;
+    }
+
+    template <typename THandler>
+    EnumDispatcher&& Default(THandler&& handler) && {
+        return std::move(Default(std::forward<THandler>(handler)));
+    }
+
+    /**
+     * @brief Checks that every instance is handled, by its own handler or the default.
+     * @throws std::logic_error naming the unhandled instances.
+     */
+    EnumDispatcher& Exhaustive() & {
+        std::size_t missing = 0;
+        for (const Slot& slot : slots_) {
+            missing += slot.invoke ? 0 : 1;
+        }
+        if (missing > 0) {
+            SmartEnumDetail::Raise<std::logic_error>([this] {
+                std::string names;
+                for (std::size_t i = 0; i < slots_.size(); ++i) {
+                    if (!slots_[i].invoke) {
+                        names += names.empty() ? "" : ", ";
+                        names += TEnum::List()[i]->Name();
+                    }
+                }
+                return "EnumDispatcher for " + std::string(SmartEnumDetail::TypeName<TEnum>()) +
+                       " has no handler for " + names;
+            });
+        }
+        return *this;
+    }
+
+    EnumDispatcher&& Exhaustive() && { return std::move(Exhaustive()); }
+
+    /**
+     * @brief True if @p instance has a handler of its own or there is a default.
+     */
+    bool Handles(const TEnum& instance) const {
+        const std::size_t index = instance.Ordinal();
+        return index < slots_.size() ? slots_[index].invoke != nullptr : default_.invoke != nullptr;
+    }
+
+    /**
+     * @brief Calls the handler of @p value with @p args.
+     * @throws std::out_of_range if @p value is not handled and there is no default.
+     */
+    R operator()(const TEnum& value, Args... args) const {
+        const std::size_t index = value.Ordinal();
+        const Slot& slot = index < slots_.size() ? slots_[index] : default_;
+        if (!slot.invoke) {
+            SmartEnumDetail::Raise<std::out_of_range>([&value] {
+                return "EnumDispatcher has no handler for " + std::string(value.Name());
+            });
+        }
+        return slot.invoke(slot.target, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Number of slots, i.e. TEnum::Count() when the dispatcher was created.
+     */
+    std::size_t Size() const { return slots_.size(); }
+
+private:
+    struct Slot {
+        R (*invoke)(const void*, Args&&...);
+        const void* target;
+    };
+
+    template <typename THandler>
+    static R call(const void* target, Args&&... args) {
+        return (*static_cast<const THandler*>(target))(std::forward<Args>(args)...);
+    }
+
+    template <typename THandler>
+    Slot store(THandler&& handler) {
+        using Handler = std::decay_t<THandler>;
+        static_assert(std::is_invocable_r_v<R, const Handler&, Args...>,
+                      "EnumDispatcher handler must be const-callable with the dispatcher's arguments");
+
+        std::shared_ptr<const Handler> owned = std::make_shared<Handler>(std::forward<THandler>(handler));
+        const Slot slot{&EnumDispatcher::call<Handler>, owned.get()};
+        handlers_.push_back(std::move(owned));
+        return slot;
+    }
+
+    /**
+     * @brief Frees the handler at @p target once no slot and not the default refer to it.
+     */
+    void release(const void* target) {
+        if (!target || default_.target == target) {
+            return;
+        }
+        for (const Slot& slot : slots_) {
+            if (slot.target == target) {
+                return;
+            }
+        }
+        for (auto it = handlers_.begin(); it != handlers_.end(); ++it) {
+            if (it->get() == target) {
+                handlers_.erase(it);
+                return;
+            }
+        }
+    }
+
+    std::vector<Slot> slots_;                            // indexed by ordinal
+    Slot default_;
+    std::vector<std::shared_ptr<const void>> handlers_;  // owns the callables the slots point to
+};
+
+/**
+ * @brief Calls @p dispatcher for every single-bit flag set in @p value, lowest bit first.
+ *
+ * Walks the set bits of @p value with count-trailing-zeros (SmartFlagEnum's
+ * Decompose()), so it costs O(popcount) and allocates nothing. @p args are
+ * passed to every handler. Bits that no single-bit flag covers are not
+ * dispatched; they are returned.
+ *
+ * @param value Combined flags: a raw value, a FlagSet or a flag instance.
+ * @return The bits of @p value that were not dispatched.
+ */
+template <typename TEnum, typename R, typename... Args, typename... TCallArgs>
+typename TEnum::ValueType ForEachFlag(const typename TEnum::ValueType& value,
+                                      const EnumDispatcher<TEnum, R(Args...)>& dispatcher, TCallArgs&&... args) {
+    const typename TEnum::DecomposeRange flags = TEnum::Decompose(value);
+    for (const TEnum& flag : flags) {
+        dispatcher(flag, args...);
+    }
+    return flags.UnmatchedBits();
+}
+
+#endif // ENUMDISPATCHER_HPP
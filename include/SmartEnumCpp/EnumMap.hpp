@@ -0,0 +1,182 @@
+/**
+ * @file EnumMap.hpp
+ * @brief Array-backed map keyed by SmartEnum (or SmartFlagEnum) instances.
+ *
+ * An EnumMap holds exactly one value per enum instance, stored contiguously
+ * and indexed by the instance's Ordinal(). Lookups are a single array index,
+ * iteration follows declaration order, and the whole map is one allocation.
+ *
+ * Example:
+ * @code
+ * EnumMap<OrderStatus, int> counts;            // one zero per status
+ * counts[OrderStatus::Shipped] += 1;
+ *
+ * EnumMap<PaymentMethod, float> limits = {
+ *     {PaymentMethod::CreditCard, 5000.0f},
+ *     {PaymentMethod::Cash, 200.0f},
+ * };
+ *
+ * for (auto [method, limit] : limits) {
+ *     std::cout << method.Name() << ": " << limit << std::endl;
+ * }
+ * @endcode
+ *
+ * The map is sized to TEnum::Count() when it is constructed. Keys work through
+ * `const TEnum&`, so polymorphic enums whose instances are derived types are
+ * supported the same way as plain ones.
+ */
+
+#ifndef ENUMMAP_HPP
+#define ENUMMAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "detail/Config.hpp"
+
+/**
+ * @brief Total map from every instance of TEnum to a value of type V.
+ *
+ * Every key is always present; a default-constructed map value-initializes
+ * each entry. Instances registered after the map was constructed are outside
+ * its range: operator[] must not be used with them, and At() throws.
+ *
+ * @tparam TEnum The SmartEnum or SmartFlagEnum type used as key.
+ * @tparam V The mapped value type; default-constructible and copy-assignable.
+ */
+template <typename TEnum, typename V>
+class EnumMap {
+    template <typename TValue>
+    class Iterator;
+
+public:
+    using key_type = TEnum;
+    using mapped_type = V;
+    using size_type = std::size_t;
+    using reference = V&;
+    using const_reference = const V&;
+    using iterator = Iterator<V>;
+    using const_iterator = Iterator<const V>;
+
+    /**
+     * @brief Creates a map with a value-initialized entry for every instance.
+     */
+    EnumMap() : size_(TEnum::Count()), values_(new V[size_]()) {}
+
+    /**
+     * @brief Creates a map with every entry set to @p value.
+     */
+    explicit EnumMap(const V& value) : EnumMap() { Fill(value); }
+
+    EnumMap(const EnumMap& other) : size_(other.size_), values_(new V[size_]) {
+        std::copy(other.values_.get(), other.values_.get() + size_, values_.get());
+    }
+
+    /**
+     * @brief Takes over @p other's entries; @p other is left empty (Size() 0).
+     */
+    EnumMap(EnumMap&& other) noexcept : size_(std::exchange(other.size_, 0)), values_(std::move(other.values_)) {}
+
+    EnumMap& operator=(const EnumMap& other) {
+        if (this != &other) {
+            EnumMap copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    EnumMap& operator=(EnumMap&& other) noexcept {
+        if (this != &other) {
+            size_ = std::exchange(other.size_, 0);
+            values_ = std::move(other.values_);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Creates a map from key/value pairs; unlisted keys are value-initialized.
+     */
+    EnumMap(std::initializer_list<std::pair<const TEnum&, V>> entries) : EnumMap() {
+        for (const auto& entry : entries) {
+            At(entry.first) = entry.second;
+        }
+    }
+
+    /**
+     * @brief Returns the value stored for @p key without bounds checking.
+     */
+    reference operator[](const TEnum& key) { return values_[key.Ordinal()]; }
+    const_reference operator[](const TEnum& key) const { return values_[key.Ordinal()]; }
+
+    /**
+     * @brief Returns the value stored for @p key.
+     * @throws std::out_of_range if @p key was registered after the map was created.
+     */
+    reference At(const TEnum& key) { return values_[checkedIndex(key)]; }
+    const_reference At(const TEnum& key) const { return values_[checkedIndex(key)]; }
+
+    /**
+     * @brief Number of entries, i.e. TEnum::Count() when the map was created.
+     */
+    size_type Size() const { return size_; }
+
+    /**
+     * @brief Assigns @p value to every entry.
+     */
+    void Fill(const V& value) { std::fill(values_.get(), values_.get() + size_, value); }
+
+    /**
+     * @brief Iterates entries in declaration order as `std::pair<const TEnum&, V&>`.
+     */
+    iterator begin() { return iterator(values_.get(), 0); }
+    iterator end() { return iterator(values_.get(), size_); }
+    const_iterator begin() const { return const_iterator(values_.get(), 0); }
+    const_iterator end() const { return const_iterator(values_.get(), size_); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+private:
+    template <typename TValue>
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::pair<const TEnum&, TValue&>;
+        using reference = value_type;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator(TValue* values, std::size_t index) : values_(values), index_(index) {}
+
+        reference operator*() const { return reference(*TEnum::List()[index_], values_[index_]); }
+        Iterator& operator++() { ++index_; return *this; }
+        Iterator operator++(int) { Iterator previous = *this; ++index_; return previous; }
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+
+    private:
+        TValue* values_;
+        std::size_t index_;
+    };
+
+    std::size_t checkedIndex(const TEnum& key) const {
+        const std::size_t index = key.Ordinal();
+        if (index >= size_) {
+            SmartEnumDetail::Raise<std::out_of_range>([&key] {
+                return "EnumMap has no entry for " + std::string(key.Name());
+            });
+        }
+        return index;
+    }
+
+    // A plain array rather than std::vector, so that EnumMap<TEnum, bool> holds real bools
+    std::size_t size_;
+    std::unique_ptr<V[]> values_;
+};
+
+#endif // ENUMMAP_HPP
@@ -0,0 +1,282 @@
+/**
+ * @file EnumSet.hpp
+ * @brief Bitset of SmartEnum instances indexed by ordinal.
+ *
+ * An EnumSet stores membership as one bit per instance Ordinal() in a fixed
+ * array of 64-bit words. Membership is a bit test, set algebra is word-wise
+ * and iteration visits members in declaration order.
+ *
+ * Example:
+ * @code
+ * const EnumSet<OrderStatus> cancellable(OrderStatus::Created, OrderStatus::Paid);
+ *
+ * if (cancellable.Contains(order.GetStatus())) {
+ *     order.Cancel();
+ * }
+ *
+ * for (const OrderStatus& status : cancellable | EnumSet<OrderStatus>(OrderStatus::Processing)) {
+ *     std::cout << status.Name() << std::endl;
+ * }
+ * @endcode
+ */
+
+#ifndef ENUMSET_HPP
+#define ENUMSET_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "detail/BitOps.hpp"
+#include "detail/Config.hpp"
+
+/**
+ * @brief Set of TEnum instances with room for ordinals below Capacity.
+ *
+ * All operations are constexpr; they become usable in constant expressions
+ * whenever the instances themselves are.
+ *
+ * @tparam TEnum The SmartEnum or SmartFlagEnum type of the members.
+ * @tparam Capacity Number of ordinals the set can hold (default 64, one word).
+ */
+template <typename TEnum, std::size_t Capacity = 64>
+class EnumSet {
+    static_assert(Capacity > 0, "EnumSet needs room for at least one member");
+
+    static constexpr std::size_t kWordBits = 64;
+    static constexpr std::size_t kWordCount = (Capacity + kWordBits - 1) / kWordBits;
+
+public:
+    class Iterator;
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    /**
+     * @brief Creates an empty set.
+     */
+    constexpr EnumSet() : words_{} {}
+
+    /**
+     * @brief Creates a set holding the given instances.
+     * @throws std::out_of_range if an instance's ordinal does not fit in Capacity.
+     */
+    template <typename... TMembers,
+              typename = std::enable_if_t<(sizeof...(TMembers) > 0) &&
+                                          (std::is_base_of_v<TEnum, TMembers> && ...)>>
+    constexpr explicit EnumSet(const TMembers&... members) : words_{} {
+        (Insert(members), ...);
+    }
+
+    /**
+     * @brief Creates a set holding every instance registered so far.
+     * @throws std::out_of_range if TEnum has more instances than Capacity.
+     */
+    static EnumSet All() {
+        EnumSet set;
+        for (const TEnum* member : TEnum::List()) {
+            set.Insert(*member);
+        }
+        return set;
+    }
+
+    /**
+     * @brief Checks whether @p member is in the set.
+     *
+     * With Capacity <= 64 this is one shift and mask of the single word, with
+     * no branch: bits at Capacity and above are never set, so only ordinals
+     * past the word need the range check.
+     */
+    constexpr bool Contains(const TEnum& member) const {
+        const std::size_t ordinal = member.Ordinal();
+        if constexpr (kWordCount == 1) {
+            return ((words_[0] >> (ordinal % kWordBits)) & std::uint64_t(ordinal < kWordBits)) != 0;
+        } else {
+            return ordinal < Capacity && ((words_[ordinal / kWordBits] >> (ordinal % kWordBits)) & 1) != 0;
+        }
+    }
+
+    /**
+     * @brief Adds @p member to the set.
+     * @throws std::out_of_range if the ordinal does not fit in Capacity.
+     */
+    constexpr EnumSet& Insert(const TEnum& member) {
+        const std::size_t ordinal = checkedOrdinal(member);
+        words_[ordinal / kWordBits] |= std::uint64_t(1) << (ordinal % kWordBits);
+        return *this;
+    }
+
+    /**
+     * @brief Removes @p member from the set if present.
+     */
+    constexpr EnumSet& Erase(const TEnum& member) {
+        const std::size_t ordinal = member.Ordinal();
+        if (ordinal < Capacity) {
+            words_[ordinal / kWordBits] &= ~(std::uint64_t(1) << (ordinal % kWordBits));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Removes every member.
+     */
+    constexpr void Clear() {
+        for (std::size_t i = 0; i < kWordCount; ++i) {
+            words_[i] = 0;
+        }
+    }
+
+    /**
+     * @brief Number of members.
+     */
+    constexpr std::size_t Size() const {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < kWordCount; ++i) {
+            count += static_cast<std::size_t>(SmartEnumDetail::PopCount(words_[i]));
+        }
+        return count;
+    }
+
+    /**
+     * @brief True if the set has no members.
+     */
+    constexpr bool Empty() const {
+        for (std::size_t i = 0; i < kWordCount; ++i) {
+            if (words_[i] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Ordinals that fit in the set.
+     */
+    static constexpr std::size_t MaxSize() { return Capacity; }
+
+    constexpr EnumSet& operator|=(const EnumSet& other) {
+        for (std::size_t i = 0; i < kWordCount; ++i) words_[i] |= other.words_[i];
+        return *this;
+    }
+
+    constexpr EnumSet& operator&=(const EnumSet& other) {
+        for (std::size_t i = 0; i < kWordCount; ++i) words_[i] &= other.words_[i];
+        return *this;
+    }
+
+    /**
+     * @brief Removes every member of @p other (set difference).
+     */
+    constexpr EnumSet& operator-=(const EnumSet& other) {
+        for (std::size_t i = 0; i < kWordCount; ++i) words_[i] &= ~other.words_[i];
+        return *this;
+    }
+
+    constexpr EnumSet& operator^=(const EnumSet& other) {
+        for (std::size_t i = 0; i < kWordCount; ++i) words_[i] ^= other.words_[i];
+        return *this;
+    }
+
+    friend constexpr EnumSet operator|(EnumSet lhs, const EnumSet& rhs) { return lhs |= rhs; }
+    friend constexpr EnumSet operator&(EnumSet lhs, const EnumSet& rhs) { return lhs &= rhs; }
+    friend constexpr EnumSet operator-(EnumSet lhs, const EnumSet& rhs) { return lhs -= rhs; }
+    friend constexpr EnumSet operator^(EnumSet lhs, const EnumSet& rhs) { return lhs ^= rhs; }
+
+    friend constexpr bool operator==(const EnumSet& lhs, const EnumSet& rhs) {
+        for (std::size_t i = 0; i < kWordCount; ++i) {
+            if (lhs.words_[i] != rhs.words_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend constexpr bool operator!=(const EnumSet& lhs, const EnumSet& rhs) { return !(lhs == rhs); }
+
+    /**
+     * @brief Iterates members in ordinal (declaration) order.
+     */
+    constexpr Iterator begin() const { return Iterator(this, nextOrdinal(0)); }
+    constexpr Iterator end() const { return Iterator(this, Capacity); }
+
+    /**
+     * @brief Forward iterator over the members of an EnumSet.
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TEnum;
+        using reference = const TEnum&;
+        using pointer = const TEnum*;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr Iterator() : set_(nullptr), ordinal_(Capacity) {}
+
+        reference operator*() const { return *TEnum::List()[ordinal_]; }
+        pointer operator->() const { return TEnum::List()[ordinal_]; }
+
+        /**
+         * @brief Ordinal of the current member.
+         */
+        constexpr std::size_t Ordinal() const { return ordinal_; }
+
+        constexpr Iterator& operator++() {
+            ordinal_ = set_->nextOrdinal(ordinal_ + 1);
+            return *this;
+        }
+
+        constexpr Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        constexpr bool operator==(const Iterator& other) const { return ordinal_ == other.ordinal_; }
+        constexpr bool operator!=(const Iterator& other) const { return ordinal_ != other.ordinal_; }
+
+    private:
+        friend class EnumSet;
+
+        constexpr Iterator(const EnumSet* set, std::size_t ordinal) : set_(set), ordinal_(ordinal) {}
+
+        const EnumSet* set_;
+        std::size_t ordinal_;
+    };
+
+private:
+    static constexpr std::size_t checkedOrdinal(const TEnum& member) {
+        const std::size_t ordinal = member.Ordinal();
+        if (ordinal >= Capacity) {
+            SmartEnumDetail::Raise<std::out_of_range>([&member] {
+                return "EnumSet capacity " + std::to_string(Capacity) +
+                       " is too small for " + std::string(member.Name());
+            });
+        }
+        return ordinal;
+    }
+
+    /**
+     * @brief Smallest member ordinal >= @p from, or Capacity if there is none.
+     */
+    constexpr std::size_t nextOrdinal(std::size_t from) const {
+        std::size_t wordIndex = from / kWordBits;
+        if (wordIndex >= kWordCount) {
+            return Capacity;
+        }
+        std::uint64_t word = words_[wordIndex] & (~std::uint64_t(0) << (from % kWordBits));
+        while (word == 0) {
+            if (++wordIndex == kWordCount) {
+                return Capacity;
+            }
+            word = words_[wordIndex];
+        }
+        return wordIndex * kWordBits + static_cast<std::size_t>(SmartEnumDetail::CountTrailingZeros(word));
+    }
+
+    std::array<std::uint64_t, kWordCount> words_;
+};
+
+#endif // ENUMSET_HPP
@@ -0,0 +1,362 @@
+/**
+ * @file FlagBitset.hpp
+ * @brief Fixed-width multi-word flag value for SmartFlagEnum types with more than 64 flags.
+ *
+ * A FlagBitset<Bits> stores its bits in an array of 64-bit words. Union,
+ * intersection and tests are plain loops over that array, which compilers
+ * unroll and vectorize, and iteration skips zero words.
+ *
+ * Example:
+ * @code
+ * using CapabilityBits = FlagBitset<160>;
+ *
+ * CapabilityBits wanted = CapabilityBits::Bit(3) | CapabilityBits::Bit(131);
+ * if (supported.HasAll(wanted)) { ... }
+ *
+ * for (std::size_t bit : wanted) { ... }   // 3, then 131
+ * @endcode
+ */
+
+#ifndef FLAGBITSET_HPP
+#define FLAGBITSET_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "detail/BitOps.hpp"
+#include "detail/Config.hpp"
+
+/**
+ * @brief Set of bit positions below Bits, usable as a SmartFlagEnum value type.
+ *
+ * @tparam Bits Number of bit positions.
+ */
+template <std::size_t Bits>
+class FlagBitset
+{
+    static_assert(Bits > 0, "FlagBitset needs at least one bit");
+
+    static constexpr std::size_t kWordBits = 64;
+
+public:
+    static constexpr std::size_t kWordCount = (Bits + kWordBits - 1) / kWordBits;
+
+    class Iterator;
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    /**
+     * @brief Creates a value with no bit set.
+     */
+    constexpr FlagBitset() : words_{} {}
+
+    /**
+     * @brief Creates a value with only bit @p index set.
+     * @throws std::out_of_range if @p index >= Bits.
+     */
+    static constexpr FlagBitset Bit(std::size_t index)
+    {
+        FlagBitset bits;
+        bits.Set(index);
+        return bits;
+    }
+
+    /**
+     * @brief Number of bit positions.
+     */
+    static constexpr std::size_t Size() { return Bits; }
+
+    /**
+     * @brief True if bit @p index is set; false for positions past Bits.
+     */
+    constexpr bool Test(std::size_t index) const
+    {
+        return index < Bits && ((words_[index / kWordBits] >> (index % kWordBits)) & 1) != 0;
+    }
+
+    /**
+     * @brief Sets bit @p index.
+     * @throws std::out_of_range if @p index >= Bits.
+     */
+    constexpr FlagBitset &Set(std::size_t index)
+    {
+        checkIndex(index);
+        words_[index / kWordBits] |= std::uint64_t(1) << (index % kWordBits);
+        return *this;
+    }
+
+    /**
+     * @brief Clears bit @p index if it is in range.
+     */
+    constexpr FlagBitset &Reset(std::size_t index)
+    {
+        if (index < Bits)
+        {
+            words_[index / kWordBits] &= ~(std::uint64_t(1) << (index % kWordBits));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief True if at least one bit is set.
+     */
+    constexpr bool Any() const
+    {
+        for (std::size_t i = 0; i < kWordCount; ++i)
+        {
+            if (words_[i] != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief True if no bit is set.
+     */
+    constexpr bool None() const { return !Any(); }
+
+    /**
+     * @brief Number of set bits.
+     */
+    constexpr std::size_t Count() const
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < kWordCount; ++i)
+        {
+            count += static_cast<std::size_t>(SmartEnumDetail::PopCount(words_[i]));
+        }
+        return count;
+    }
+
+    /**
+     * @brief True if every bit of @p other is set.
+     */
+    constexpr bool HasAll(const FlagBitset &other) const
+    {
+        for (std::size_t i = 0; i < kWordCount; ++i)
+        {
+            if ((words_[i] & other.words_[i]) != other.words_[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief True if at least one bit of @p other is set.
+     */
+    constexpr bool HasAny(const FlagBitset &other) const
+    {
+        for (std::size_t i = 0; i < kWordCount; ++i)
+        {
+            if ((words_[i] & other.words_[i]) != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Gets word @p index (bits 64 * index and up).
+     */
+    constexpr std::uint64_t Word(std::size_t index) const { return words_[index]; }
+
+    /**
+     * @brief Formats the value as hexadecimal, most significant digit first.
+     */
+    std::string ToString() const
+    {
+        static const char digits[] = "0123456789abcdef";
+        std::string text;
+        for (std::size_t i = kWordCount; i-- > 0;)
+        {
+            for (int shift = 60; shift >= 0; shift -= 4)
+            {
+                const char digit = digits[(words_[i] >> shift) & 0xf];
+                if (!text.empty() || digit != '0')
+                {
+                    text += digit;
+                }
+            }
+        }
+        return "0x" + (text.empty() ? std::string("0") : text);
+    }
+
+    constexpr FlagBitset &operator|=(const FlagBitset &other)
+    {
+        for (std::size_t i = 0; i < kWordCount; ++i) words_[i] |= other.words_[i];
+        return *this;
+    }
+
+    constexpr FlagBitset &operator&=(const FlagBitset &other)
+    {
+        for (std::size_t i = 0; i < kWordCount; ++i) words_[i] &= other.words_[i];
+        return *this;
+    }
+
+    constexpr FlagBitset &operator^=(const FlagBitset &other)
+    {
+        for (std::size_t i = 0; i < kWordCount; ++i) words_[i] ^= other.words_[i];
+        return *this;
+    }
+
+    friend constexpr FlagBitset operator|(FlagBitset lhs, const FlagBitset &rhs) { return lhs |= rhs; }
+    friend constexpr FlagBitset operator&(FlagBitset lhs, const FlagBitset &rhs) { return lhs &= rhs; }
+    friend constexpr FlagBitset operator^(FlagBitset lhs, const FlagBitset &rhs) { return lhs ^= rhs; }
+
+    /**
+     * @brief Complement within the Bits positions; bits past Bits stay clear.
+     */
+    friend constexpr FlagBitset operator~(FlagBitset bits)
+    {
+        for (std::size_t i = 0; i < kWordCount; ++i) bits.words_[i] = ~bits.words_[i];
+        bits.words_[kWordCount - 1] &= tailMask();
+        return bits;
+    }
+
+    friend constexpr bool operator==(const FlagBitset &lhs, const FlagBitset &rhs)
+    {
+        for (std::size_t i = 0; i < kWordCount; ++i)
+        {
+            if (lhs.words_[i] != rhs.words_[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend constexpr bool operator!=(const FlagBitset &lhs, const FlagBitset &rhs) { return !(lhs == rhs); }
+
+    /**
+     * @brief Numeric order (most significant word first), used by the sorted value index.
+     */
+    friend constexpr bool operator<(const FlagBitset &lhs, const FlagBitset &rhs)
+    {
+        for (std::size_t i = kWordCount; i-- > 0;)
+        {
+            if (lhs.words_[i] != rhs.words_[i])
+            {
+                return lhs.words_[i] < rhs.words_[i];
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Iterates the set bit positions, lowest first.
+     */
+    constexpr Iterator begin() const { return Iterator(*this, nextBit(0)); }
+    constexpr Iterator end() const { return Iterator(FlagBitset(), Bits); }
+
+    /**
+     * @brief Forward iterator over set bit positions.
+     *
+     * Holds its own copy of the remaining bits, so it stays valid after the
+     * FlagBitset it came from is gone.
+     */
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::size_t;
+        using reference = std::size_t;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr Iterator() : index_(Bits) {}
+
+        constexpr std::size_t operator*() const { return index_; }
+
+        constexpr Iterator &operator++()
+        {
+            remaining_.Reset(index_);
+            index_ = remaining_.nextBit(index_ + 1);
+            return *this;
+        }
+
+        constexpr Iterator operator++(int)
+        {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        constexpr bool operator==(const Iterator &other) const { return index_ == other.index_; }
+        constexpr bool operator!=(const Iterator &other) const { return index_ != other.index_; }
+
+    private:
+        friend class FlagBitset;
+
+        constexpr Iterator(const FlagBitset &remaining, std::size_t index) : remaining_(remaining), index_(index) {}
+
+        FlagBitset remaining_;
+        std::size_t index_;
+    };
+
+private:
+    static constexpr std::uint64_t tailMask()
+    {
+        return Bits % kWordBits == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << (Bits % kWordBits)) - 1;
+    }
+
+    static constexpr void checkIndex(std::size_t index)
+    {
+        if (index >= Bits)
+        {
+            SmartEnumDetail::Raise<std::out_of_range>([index]
+            {
+                return "FlagBitset bit " + std::to_string(index) + " is out of range for " +
+                       std::to_string(Bits) + " bits";
+            });
+        }
+    }
+
+    /**
+     * @brief Smallest set bit >= @p from, or Bits if there is none; zero words are skipped whole.
+     */
+    constexpr std::size_t nextBit(std::size_t from) const
+    {
+        std::size_t wordIndex = from / kWordBits;
+        if (wordIndex >= kWordCount)
+        {
+            return Bits;
+        }
+        std::uint64_t word = words_[wordIndex] & (~std::uint64_t(0) << (from % kWordBits));
+        while (word == 0)
+        {
+            if (++wordIndex == kWordCount)
+            {
+                return Bits;
+            }
+            word = words_[wordIndex];
+        }
+        return wordIndex * kWordBits + static_cast<std::size_t>(SmartEnumDetail::CountTrailingZeros(word));
+    }
+
+    std::array<std::uint64_t, kWordCount> words_;
+};
+
+/**
+ * @brief True for FlagBitset instantiations.
+ */
+template <typename T>
+struct IsFlagBitset : std::false_type
+{
+};
+
+template <std::size_t Bits>
+struct IsFlagBitset<FlagBitset<Bits>> : std::true_type
+{
+};
+
+#endif // FLAGBITSET_HPP
@@ -0,0 +1,154 @@
+/**
+ * @file FlagSet.hpp
+ * @brief Typed combination of SmartFlagEnum flags with constexpr bitwise algebra.
+ *
+ * A FlagSet wraps a combined flag value together with its flag type, so
+ * combining flags no longer degrades to a raw integer. It is trivially
+ * copyable, the same size as the underlying value, and every operation that
+ * does not consult the flag registry is constexpr.
+ *
+ * Example:
+ * @code
+ * FlagSet<Permission> granted = Permission::Read | Permission::Write;
+ *
+ * if (granted.HasFlag(Permission::Write)) { ... }
+ * if (granted.HasAny(Permission::Write | Permission::Delete)) { ... }
+ *
+ * granted &= ~FlagSet<Permission>(Permission::Write);
+ * int raw = granted;                            // converts to the underlying value
+ * @endcode
+ */
+
+#ifndef FLAGSET_HPP
+#define FLAGSET_HPP
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "detail/BitOps.hpp"
+
+/**
+ * @brief Set of flags of TEnum stored as one combined value.
+ *
+ * @tparam TEnum The SmartFlagEnum type.
+ */
+template <typename TEnum>
+class FlagSet
+{
+public:
+    using ValueType = typename TEnum::ValueType;
+    using iterator = typename TEnum::DecomposeRange::Iterator;
+    using const_iterator = iterator;
+
+    /**
+     * @brief Creates an empty set (value 0).
+     */
+    constexpr FlagSet() : value_(0) {}
+
+    /**
+     * @brief Creates a set holding a single flag instance.
+     */
+    constexpr FlagSet(const TEnum &flag) : value_(flag.Value()) {}
+
+    /**
+     * @brief Creates a set from a raw combined value.
+     */
+    constexpr explicit FlagSet(ValueType value) : value_(value) {}
+
+    /**
+     * @brief Creates a set from a list of flag instances, e.g. the result of FromValue().
+     */
+    explicit FlagSet(const std::vector<const TEnum *> &flags) : value_(0)
+    {
+        for (const TEnum *flag : flags)
+        {
+            value_ = static_cast<ValueType>(value_ | flag->Value());
+        }
+    }
+
+    /**
+     * @brief Gets the combined value.
+     */
+    constexpr ValueType Value() const { return value_; }
+
+    /**
+     * @brief Implicit conversion to the underlying value type.
+     */
+    constexpr operator ValueType() const { return value_; }
+
+    /**
+     * @brief True if every bit of @p flag is set.
+     */
+    constexpr bool HasFlag(const TEnum &flag) const { return HasAll(FlagSet(flag)); }
+
+    /**
+     * @brief True if at least one bit of @p other is set.
+     */
+    constexpr bool HasAny(FlagSet other) const { return (value_ & other.value_) != 0; }
+
+    /**
+     * @brief True if every bit of @p other is set.
+     */
+    constexpr bool HasAll(FlagSet other) const { return (value_ & other.value_) == other.value_; }
+
+    /**
+     * @brief True if no bit is set.
+     */
+    constexpr bool Empty() const { return value_ == 0; }
+
+    /**
+     * @brief Number of set bits.
+     */
+    constexpr int Count() const
+    {
+        return SmartEnumDetail::PopCount(static_cast<std::make_unsigned_t<ValueType>>(value_));
+    }
+
+    /**
+     * @brief Returns the flag instances of this value, as FromValue() does.
+     * @throws InvalidFlagEnumValueParseException if the value cannot be expressed with the defined flags.
+     */
+    std::vector<const TEnum *> ToList() const { return TEnum::FromValue(value_); }
+
+    /**
+     * @brief Returns the comma-separated flag names, as FromValueToString() does.
+     */
+    std::string ToString() const { return TEnum::FromValueToString(value_); }
+
+    /**
+     * @brief Iterates the single-bit flags that are set, lowest bit first (see Decompose()).
+     */
+    iterator begin() const { return TEnum::Decompose(value_).begin(); }
+    iterator end() const { return TEnum::Decompose(value_).end(); }
+
+    constexpr FlagSet &operator|=(FlagSet other)
+    {
+        value_ = static_cast<ValueType>(value_ | other.value_);
+        return *this;
+    }
+
+    constexpr FlagSet &operator&=(FlagSet other)
+    {
+        value_ = static_cast<ValueType>(value_ & other.value_);
+        return *this;
+    }
+
+    constexpr FlagSet &operator^=(FlagSet other)
+    {
+        value_ = static_cast<ValueType>(value_ ^ other.value_);
+        return *this;
+    }
+
+    friend constexpr FlagSet operator|(FlagSet lhs, FlagSet rhs) { return lhs |= rhs; }
+    friend constexpr FlagSet operator&(FlagSet lhs, FlagSet rhs) { return lhs &= rhs; }
+    friend constexpr FlagSet operator^(FlagSet lhs, FlagSet rhs) { return lhs ^= rhs; }
+    friend constexpr FlagSet operator~(FlagSet set) { return FlagSet(static_cast<ValueType>(~set.value_)); }
+    friend constexpr bool operator==(FlagSet lhs, FlagSet rhs) { return lhs.value_ == rhs.value_; }
+    friend constexpr bool operator!=(FlagSet lhs, FlagSet rhs) { return lhs.value_ != rhs.value_; }
+
+private:
+    ValueType value_;
+};
+
+#endif // FLAGSET_HPP
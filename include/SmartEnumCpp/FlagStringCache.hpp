@@ -0,0 +1,277 @@
+/**
+ * @file FlagStringCache.hpp
+ * @brief Opt-in memoization of SmartFlagEnum::FromValueToString.
+ *
+ * Logging tends to format the same few flag combinations over and over. A
+ * FlagStringCache keeps the formatted text of combinations it has seen in a
+ * fixed number of entries and hands out std::string_view results that stay
+ * valid for the lifetime of the cache.
+ *
+ * Example:
+ * @code
+ * static FlagStringCache<Permission> permissionNames;
+ *
+ * std::string overflow;
+ * std::string_view text = permissionNames.Format(mask, overflow);  // formatted once per combination
+ * logger.write(text.data(), text.size());
+ * @endcode
+ *
+ * The cache is set-associative: a value hashes to a set of Ways entries and
+ * takes the first free one. Entries are filled once and never evicted, so
+ * readers never see a string change under them, and the cache never grows.
+ * A value whose set is full is formatted into the caller's overflow string
+ * instead, and the returned view points there. Any number of threads may call
+ * Format() concurrently.
+ */
+
+#ifndef FLAGSTRINGCACHE_HPP
+#define FLAGSTRINGCACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "SmartFlagEnum.hpp"
+#include "detail/Config.hpp"
+
+/**
+ * @brief Bounded cache of formatted flag combinations.
+ *
+ * Holds at most Capacity formatted strings, allocated as they are first
+ * filled. Hits() and Misses() are counted in a few cache-line-sized shards,
+ * picked per thread, so threads formatting concurrently rarely share a
+ * counter; each call still costs one relaxed atomic add.
+ *
+ * @tparam TEnum The SmartFlagEnum type.
+ * @tparam Capacity Number of entries; must be a power of two and a multiple of Ways.
+ * @tparam Ways Entries per set, i.e. how many values hashing to the same set can be cached.
+ */
+template <typename TEnum, std::size_t Capacity = 64, std::size_t Ways = 4>
+class FlagStringCache
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "FlagStringCache capacity must be a power of two");
+    static_assert(Ways > 0 && Capacity % Ways == 0, "FlagStringCache capacity must be a multiple of its ways");
+
+public:
+    using ValueType = typename TEnum::ValueType;
+
+    FlagStringCache() = default;
+    FlagStringCache(const FlagStringCache &) = delete;
+    FlagStringCache &operator=(const FlagStringCache &) = delete;
+
+    ~FlagStringCache() { delete precomputed_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Formats @p value as FromValueToString() would, reusing cached text.
+     *
+     * @param value The combined flag value.
+     * @param outText Receives the formatted names: a view into the cache, or
+     *        into @p overflow if the value's set is full.
+     * @param overflow Caller-owned storage, written only when the value cannot be cached.
+     * @return false if the value is not a valid flag combination.
+     */
+    bool TryFormat(ValueType value, std::string_view &outText, std::string &overflow)
+    {
+        if (const Precomputed *table = precomputed_.load(std::memory_order_acquire))
+        {
+            const bool found = table->TryGet(value, outText);
+            count(found);
+            return found;
+        }
+
+        Entry *set = entries_ + setIndex(value) * Ways;
+        for (std::size_t way = 0; way < Ways; ++way)
+        {
+            const Entry &entry = set[way];
+            if (entry.state.load(std::memory_order_acquire) == kReady && entry.value == value)
+            {
+                count(true);
+                outText = entry.text;
+                return true;
+            }
+        }
+
+        count(false);
+        for (std::size_t way = 0; way < Ways; ++way)
+        {
+            // Claim a free entry; its text is written before it becomes visible as ready.
+            Entry &entry = set[way];
+            std::uint8_t expected = kFree;
+            if (entry.state.load(std::memory_order_relaxed) == kFree &&
+                entry.state.compare_exchange_strong(expected, kWriting, std::memory_order_acquire))
+            {
+                if (!TEnum::TryFromValueToString(value, entry.text))
+                {
+                    entry.state.store(kFree, std::memory_order_release);
+                    return false;
+                }
+                entry.value = value;
+                entry.state.store(kReady, std::memory_order_release);
+                outText = entry.text;
+                return true;
+            }
+        }
+
+        if (!TEnum::TryFromValueToString(value, overflow))
+        {
+            return false;
+        }
+        outText = overflow;
+        return true;
+    }
+
+    /**
+     * @brief Formats @p value as FromValueToString() would, reusing cached text.
+     *
+     * The result views the cache, or @p overflow if the value's set is full.
+     * @throws InvalidFlagEnumValueParseException if the value is not a valid flag combination.
+     */
+    std::string_view Format(ValueType value, std::string &overflow)
+    {
+        std::string_view text;
+        if (!TryFormat(value, text, overflow))
+        {
+            SmartEnumDetail::Raise<InvalidFlagEnumValueParseException>([value]
+            {
+                return "Value " + std::to_string(static_cast<long long>(value)) +
+                       " could not be converted to a valid flag string for " +
+                       std::string(SmartEnumDetail::TypeName<TEnum>());
+            });
+        }
+        return text;
+    }
+
+    /**
+     * @brief Formats every valid combination up front (8- and 16-bit flag types only).
+     *
+     * Afterwards every Format() is a table lookup, and every result stays
+     * valid for the lifetime of the cache. Call it once, before the cache is
+     * shared or from a single thread; later calls do nothing.
+     */
+    void PrecomputeAll()
+    {
+        static_assert(sizeof(ValueType) <= 2, "PrecomputeAll is limited to 8- and 16-bit flag types");
+        if (precomputed_.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        std::unique_ptr<Precomputed> table(new Precomputed());
+        table->Build();
+        const Precomputed *expected = nullptr;
+        if (precomputed_.compare_exchange_strong(expected, table.get(), std::memory_order_acq_rel))
+        {
+            table.release();
+        }
+    }
+
+    /**
+     * @brief Number of Format() calls answered from the cache.
+     */
+    std::uint64_t Hits() const { return total(&Counter::hits); }
+
+    /**
+     * @brief Number of Format() calls that had to format (or rejected the value).
+     */
+    std::uint64_t Misses() const { return total(&Counter::misses); }
+
+private:
+    static constexpr std::uint8_t kFree = 0;
+    static constexpr std::uint8_t kWriting = 1;
+    static constexpr std::uint8_t kReady = 2;
+    static constexpr std::size_t kCounterShards = 4;
+
+    struct Entry
+    {
+        std::atomic<std::uint8_t> state{kFree};
+        ValueType value{};
+        std::string text; // written once, before state becomes kReady
+    };
+
+    struct alignas(64) Counter
+    {
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+    };
+
+    // Every formatted combination of a narrow flag type, indexed by the value's bit pattern.
+    struct Precomputed
+    {
+        using Bits = std::make_unsigned_t<ValueType>;
+        static constexpr std::uint32_t kInvalid = std::numeric_limits<std::uint32_t>::max();
+
+        std::string text;                 // all names, back to back
+        std::vector<std::uint32_t> begin; // offset into text, or kInvalid
+        std::vector<std::uint32_t> end;
+
+        void Build()
+        {
+            const std::size_t count = std::size_t(std::numeric_limits<Bits>::max()) + 1;
+            begin.assign(count, kInvalid);
+            end.assign(count, kInvalid);
+            std::string formatted;
+            for (std::size_t bits = 0; bits < count; ++bits)
+            {
+                if (TEnum::TryFromValueToString(static_cast<ValueType>(static_cast<Bits>(bits)), formatted))
+                {
+                    begin[bits] = static_cast<std::uint32_t>(text.size());
+                    text += formatted;
+                    end[bits] = static_cast<std::uint32_t>(text.size());
+                }
+            }
+            text.shrink_to_fit();
+        }
+
+        bool TryGet(ValueType value, std::string_view &outText) const
+        {
+            const Bits bits = static_cast<Bits>(value);
+            if (begin[bits] == kInvalid)
+            {
+                return false;
+            }
+            outText = std::string_view(text.data() + begin[bits], end[bits] - begin[bits]);
+            return true;
+        }
+    };
+
+    static std::size_t setIndex(ValueType value)
+    {
+        const std::uint64_t mixed = static_cast<std::uint64_t>(value) * 0x9e3779b97f4a7c15ULL;
+        return static_cast<std::size_t>(mixed >> 32) & (Capacity / Ways - 1);
+    }
+
+    // Each thread keeps to one shard, assigned round-robin on its first call.
+    static std::size_t counterShard()
+    {
+        static std::atomic<std::size_t> next{0};
+        static thread_local const std::size_t shard = next.fetch_add(1, std::memory_order_relaxed) % kCounterShards;
+        return shard;
+    }
+
+    void count(bool hit)
+    {
+        Counter &counter = counters_[counterShard()];
+        (hit ? counter.hits : counter.misses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::uint64_t total(std::atomic<std::uint64_t> Counter::*field) const
+    {
+        std::uint64_t sum = 0;
+        for (const Counter &counter : counters_)
+        {
+            sum += (counter.*field).load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    Entry entries_[Capacity];
+    std::atomic<const Precomputed *> precomputed_{nullptr};
+    Counter counters_[kCounterShards];
+};
+
+#endif // FLAGSTRINGCACHE_HPP
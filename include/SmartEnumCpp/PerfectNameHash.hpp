@@ -0,0 +1,280 @@
+/**
+ * @file PerfectNameHash.hpp
+ * @brief Compile-time minimal perfect hash over a fixed set of enum names.
+ *
+ * A SmartEnum (or SmartFlagEnum) whose names are known up front can declare
+ * them once as a constexpr PerfectNameHash. Name lookups then cost one hash
+ * and one string compare instead of a binary search.
+ *
+ * Example:
+ * @code
+ * class Color : public SmartEnum<Color> {
+ * public:
+ *     static constexpr auto NameHash = MakePerfectNameHash("Red", "Green", "Blue");
+ *     static const Color Red;
+ *     static const Color Green;
+ *     static const Color Blue;
+ * private:
+ *     Color(const std::string& name, int value) : SmartEnum(name, value) {}
+ * };
+ * @endcode
+ *
+ * The table is built with the "hash, displace and compress" scheme: names are
+ * grouped into buckets by a first hash, and each bucket gets a seed that
+ * scatters its names into free slots of a table with exactly one slot per
+ * name. A second table over ASCII-folded names serves case-insensitive lookups.
+ */
+
+#ifndef PERFECTNAMEHASH_HPP
+#define PERFECTNAMEHASH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+#include "detail/AsciiCase.hpp"
+#include "detail/Config.hpp"
+
+namespace SmartEnumDetail {
+
+/**
+ * @brief Reached only when a PerfectNameHash is given the same name twice.
+ *
+ * Not constexpr on purpose: in a constant expression the call itself is the
+ * compile error, and its name explains it.
+ */
+inline void perfectNameHashDuplicateName() {
+    Raise<std::invalid_argument>([] { return "PerfectNameHash names must be unique"; });
+}
+
+/**
+ * @brief Seeded word-at-a-time string hash, optionally over ASCII-folded bytes.
+ *
+ * Eight bytes are folded and mixed per step; a final avalanche spreads every
+ * input bit over the low bits used to pick a slot.
+ */
+template <bool Fold>
+constexpr std::uint32_t nameHash(std::uint32_t seed, std::string_view name) {
+    constexpr std::uint64_t kMul = 0x9e3779b97f4a7c15ULL;
+    std::uint64_t h = (static_cast<std::uint64_t>(seed) * 0xff51afd7ed558ccdULL) ^ name.size();
+    std::size_t i = 0;
+    for (; i + 8 <= name.size(); i += 8) {
+        const std::uint64_t word = LoadWord(name.data() + i);
+        h = (h ^ (Fold ? AsciiToLower8(word) : word)) * kMul;
+        h ^= h >> 29;
+    }
+    if (i < name.size()) {
+        const std::uint64_t word = LoadPartialWord(name.data() + i, name.size() - i);
+        h = (h ^ (Fold ? AsciiToLower8(word) : word)) * kMul;
+        h ^= h >> 29;
+    }
+    h ^= h >> 32;
+    h *= 0xd6e8feb86659fd93ULL;
+    h ^= h >> 32;
+    return static_cast<std::uint32_t>(h);
+}
+
+/**
+ * @brief One displacement table plus its slot-to-name mapping.
+ */
+template <std::size_t N, bool Fold>
+struct PerfectHashTable {
+    static constexpr std::size_t kEmpty = static_cast<std::size_t>(-1);
+
+    std::array<std::int32_t, N> displacement{};
+    std::array<std::size_t, N> slots{};
+
+    constexpr std::size_t slotOf(std::string_view name) const {
+        const std::int32_t d = displacement[nameHash<Fold>(0, name) % N];
+        return d < 0 ? static_cast<std::size_t>(-d - 1) : nameHash<Fold>(static_cast<std::uint32_t>(d), name) % N;
+    }
+
+    /**
+     * @brief Builds the table for the given names.
+     *
+     * Equal names always share a first-level bucket, so duplicates are found by
+     * comparing bucket members only. For the folded table a name equal to an
+     * earlier one under case folding is left out, so the first one declared wins.
+     */
+    constexpr void build(const std::array<std::string_view, N>& names) {
+        std::array<std::size_t, N> bucketOf{};
+        std::array<std::size_t, N> bucketStart{};
+        std::array<std::size_t, N> bucketSize{};
+        std::array<std::size_t, N> members{};
+
+        // Counting sort of the names by first-level bucket, keeping declaration order.
+        for (std::size_t i = 0; i < N; ++i) {
+            bucketOf[i] = nameHash<Fold>(0, names[i]) % N;
+            ++bucketSize[bucketOf[i]];
+        }
+        for (std::size_t b = 1; b < N; ++b) {
+            bucketStart[b] = bucketStart[b - 1] + bucketSize[b - 1];
+        }
+        std::array<std::size_t, N> fill{};
+        for (std::size_t i = 0; i < N; ++i) {
+            members[bucketStart[bucketOf[i]] + fill[bucketOf[i]]++] = i;
+        }
+
+        std::size_t largest = 0;
+        for (std::size_t b = 0; b < N; ++b) {
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < bucketSize[b]; ++i) {
+                const std::size_t candidate = members[bucketStart[b] + i];
+                bool duplicate = false;
+                for (std::size_t j = 0; j < kept; ++j) {
+                    const std::string_view earlier = names[members[bucketStart[b] + j]];
+                    if (Fold ? EqualsIgnoreCase(earlier, names[candidate]) : earlier == names[candidate]) {
+                        duplicate = true;
+                    }
+                }
+                if (duplicate && !Fold) {
+                    perfectNameHashDuplicateName();
+                }
+                if (!duplicate) {
+                    members[bucketStart[b] + kept++] = candidate;
+                }
+            }
+            bucketSize[b] = kept;
+            largest = kept > largest ? kept : largest;
+        }
+
+        std::array<bool, N> taken{};
+        for (std::size_t s = 0; s < N; ++s) {
+            slots[s] = kEmpty;
+        }
+
+        // Largest buckets first: they are the hardest to place.
+        for (std::size_t size = largest; size > 1; --size) {
+            for (std::size_t b = 0; b < N; ++b) {
+                if (bucketSize[b] != size) {
+                    continue;
+                }
+                for (std::uint32_t seed = 1;; ++seed) {
+                    if (tryPlace(names, members, bucketStart[b], bucketStart[b] + size, seed, taken)) {
+                        displacement[b] = static_cast<std::int32_t>(seed);
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Single-name buckets go straight into the remaining free slots.
+        std::size_t freeSlot = 0;
+        for (std::size_t b = 0; b < N; ++b) {
+            if (bucketSize[b] != 1) {
+                continue;
+            }
+            while (taken[freeSlot]) {
+                ++freeSlot;
+            }
+            taken[freeSlot] = true;
+            slots[freeSlot] = members[bucketStart[b]];
+            displacement[b] = -static_cast<std::int32_t>(freeSlot) - 1;
+        }
+    }
+
+private:
+    constexpr bool tryPlace(const std::array<std::string_view, N>& names, const std::array<std::size_t, N>& members,
+                            std::size_t begin, std::size_t end, std::uint32_t seed, std::array<bool, N>& taken) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::size_t slot = nameHash<Fold>(seed, names[members[i]]) % N;
+            if (taken[slot]) {
+                return false;
+            }
+            for (std::size_t j = begin; j < i; ++j) {
+                if (nameHash<Fold>(seed, names[members[j]]) % N == slot) {
+                    return false;
+                }
+            }
+        }
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::size_t slot = nameHash<Fold>(seed, names[members[i]]) % N;
+            taken[slot] = true;
+            slots[slot] = members[i];
+        }
+        return true;
+    }
+};
+
+} // namespace SmartEnumDetail
+
+/**
+ * @brief Minimal perfect hash from a fixed list of names to their positions.
+ *
+ * @tparam N The number of names.
+ */
+template <std::size_t N>
+class PerfectNameHash {
+    static_assert(N > 0, "PerfectNameHash needs at least one name");
+
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Builds both tables; intended to run at compile time.
+     *
+     * @param names The names, typically in declaration order. Must be unique.
+     */
+    constexpr explicit PerfectNameHash(const std::array<std::string_view, N>& names) : names_(names) {
+        exact_.build(names_);
+        folded_.build(names_);
+    }
+
+    /**
+     * @brief Gets the number of names.
+     */
+    static constexpr std::size_t Size() { return N; }
+
+    /**
+     * @brief Gets the name at the given position.
+     */
+    constexpr std::string_view Name(std::size_t index) const { return names_[index]; }
+
+    /**
+     * @brief Returns the position of an exactly matching name, or npos.
+     */
+    constexpr std::size_t Find(std::string_view name) const {
+        const std::size_t index = exact_.slots[exact_.slotOf(name)];
+        return names_[index] == name ? index : npos;
+    }
+
+    /**
+     * @brief Returns the position of the first name matching under ASCII case folding, or npos.
+     */
+    constexpr std::size_t FindIgnoreCase(std::string_view name) const {
+        const std::size_t index = folded_.slots[folded_.slotOf(name)];
+        return index != npos && SmartEnumDetail::EqualsIgnoreCase(names_[index], name) ? index : npos;
+    }
+
+private:
+    std::array<std::string_view, N> names_;
+    SmartEnumDetail::PerfectHashTable<N, false> exact_;
+    SmartEnumDetail::PerfectHashTable<N, true> folded_;
+};
+
+/**
+ * @brief Builds a PerfectNameHash from a list of names, deducing the count.
+ */
+template <typename... TNames>
+constexpr PerfectNameHash<sizeof...(TNames)> MakePerfectNameHash(const TNames&... names) {
+    return PerfectNameHash<sizeof...(TNames)>(std::array<std::string_view, sizeof...(TNames)>{{names...}});
+}
+
+namespace SmartEnumDetail {
+
+/**
+ * @brief Detects an enum type that declares `static constexpr ... NameHash`.
+ */
+template <typename TEnum, typename = void>
+struct HasPerfectNameHash : std::false_type {};
+
+template <typename TEnum>
+struct HasPerfectNameHash<TEnum, std::void_t<decltype(TEnum::NameHash.Find(std::string_view()))>>
+    : std::true_type {};
+
+} // namespace SmartEnumDetail
+
+#endif // PERFECTNAMEHASH_HPP
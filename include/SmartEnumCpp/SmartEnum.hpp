@@ -24,12 +24,14 @@
 
 #include <vector>
 #include <string>
+#include <string_view>
 #include <algorithm>
-#include <cctype>
-#include <map>
-#include <mutex>
 #include <stdexcept>
-#include <typeinfo>
+#include <type_traits>
+#include <cstdint>
+
+#include "SmartEnumResult.hpp"
+#include "detail/Registry.hpp"
 
 /**
  * @brief Exception thrown when a SmartEnum lookup fails.
@@ -64,6 +66,14 @@ public:
      */
     inline const ValueType& Value() const { return value_; }
 
+    /**
+     * @brief Gets the zero-based registration position of the enum instance.
+     *
+     * Ordinals are dense (0..Count()-1) and match the instance's index in List(),
+     * which makes them suitable as array indexes.
+     */
+    inline std::size_t Ordinal() const { return ordinal_; }
+
     /**
      * @brief Equality operator compares underlying values.
      */
@@ -89,17 +99,46 @@ public:
     /**
      * @brief Returns a list of all defined enum instances.
      */
-    static const std::vector<const TEnum*>& List() { return instances(); }
+    static const std::vector<const TEnum*>& List() { return registry().Lookup().instances; }
+
+    /**
+     * @brief Returns the number of defined enum instances.
+     */
+    static std::size_t Count() { return registry().Size(); }
+
+    /**
+     * @brief Compacts the lookup indexes into flat sorted arrays.
+     *
+     * Lookups freeze automatically the first time they run, so calling this is
+     * optional; doing it once after static initialization moves that one-time
+     * cost off the first lookup. Instances registered later are folded in by
+     * the next lookup.
+     */
+    static void Freeze() { registry().Freeze(); }
 
     /**
      * @brief Returns an enum instance by name.
      * 
+     * Accepts std::string, string literals and std::string_view; the lookup
+     * itself never allocates.
+     *
      * @param name The name of the enum instance.
      * @param ignoreCase If true, perform a case-insensitive search.
      * @return The matching enum instance.
      * @throws SmartEnumNotFoundException if not found.
      */
-    static const TEnum& FromName(const std::string& name, bool ignoreCase = false);
+    static const TEnum& FromName(std::string_view name, bool ignoreCase = false);
+
+    /**
+     * @brief Returns an enum instance by a name given as pointer and length.
+     *
+     * Useful for tokens that live inside a larger, non-terminated buffer.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static const TEnum& FromName(const char* name, TSize length, bool ignoreCase = false) {
+        return FromName(std::string_view(name, static_cast<std::size_t>(length)), ignoreCase);
+    }
     
     /**
      * @brief Tries to get an enum instance by name.
@@ -109,7 +148,16 @@ public:
      * @param ignoreCase If true, perform a case-insensitive search.
      * @return true if found; false otherwise.
      */
-    static bool TryFromName(const std::string& name, const TEnum*& outResult, bool ignoreCase = false);
+    static bool TryFromName(std::string_view name, const TEnum*& outResult, bool ignoreCase = false);
+
+    /**
+     * @brief Tries to get an enum instance by a name given as pointer and length.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static bool TryFromName(const char* name, TSize length, const TEnum*& outResult, bool ignoreCase = false) {
+        return TryFromName(std::string_view(name, static_cast<std::size_t>(length)), outResult, ignoreCase);
+    }
     
     /**
      * @brief Returns an enum instance by its underlying value.
@@ -129,6 +177,42 @@ public:
      */
     static bool TryFromValue(const ValueType& value, const TEnum*& outResult);
 
+    /**
+     * @brief Looks up an enum instance by name without throwing or allocating.
+     *
+     * @param name The name to search.
+     * @param ignoreCase If true, perform a case-insensitive search.
+     * @return The matching instance, or SmartEnumErrc::NameNotFound.
+     */
+    static SmartEnumResult<const TEnum&> FindName(std::string_view name, bool ignoreCase = false) {
+        if (const TEnum* result = TryFromNameInternal(name, ignoreCase)) {
+            return *result;
+        }
+        return SmartEnumErrc::NameNotFound;
+    }
+
+    /**
+     * @brief Looks up an enum instance by a name given as pointer and length, without throwing.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static SmartEnumResult<const TEnum&> FindName(const char* name, TSize length, bool ignoreCase = false) {
+        return FindName(std::string_view(name, static_cast<std::size_t>(length)), ignoreCase);
+    }
+
+    /**
+     * @brief Looks up an enum instance by value without throwing or allocating.
+     *
+     * @param value The underlying value.
+     * @return The matching instance, or SmartEnumErrc::ValueNotFound.
+     */
+    static SmartEnumResult<const TEnum&> FindValue(const ValueType& value) {
+        if (const TEnum* result = TryFromValueInternal(value)) {
+            return *result;
+        }
+        return SmartEnumErrc::ValueNotFound;
+    }
+
 protected:
     /**
      * @brief Protected constructor. Registers this instance.
@@ -142,33 +226,34 @@ protected:
 private:
     std::string name_;
     ValueType value_;
+    std::size_t ordinal_;
 
-    static std::vector<const TEnum*>& instances();
-    static std::map<std::string, const TEnum*>& nameMap();
-    static std::map<std::string, const TEnum*>& nameMapIgnoreCase();
-    static std::map<ValueType, const TEnum*>& valueMap();
-    static std::once_flag listInitFlag_;
+    using Registry = SmartEnumDetail::Registry<TEnum, ValueType>;
+
+    static Registry& registry();
 
     static std::string valueToString(const ValueType& val);
-    static void registerInstance(const TEnum* instance);
-    static const TEnum* TryFromNameInternal(const std::string& name, bool ignoreCase);
+    static void registerInstance(const TEnum* instance, std::size_t& outOrdinal);
+    static const TEnum* TryFromNameInternal(std::string_view name, bool ignoreCase);
     static const TEnum* TryFromValueInternal(const ValueType& value);
 };
 
 // Template method implementations for SmartEnum
 
 template <typename TEnum, typename TValue>
-const TEnum& SmartEnum<TEnum, TValue>::FromName(const std::string& name, bool ignoreCase) {
+const TEnum& SmartEnum<TEnum, TValue>::FromName(std::string_view name, bool ignoreCase) {
     const TEnum* result = nullptr;
     if (!TryFromName(name, result, ignoreCase)) {
-        throw SmartEnumNotFoundException("No " + std::string(typeid(TEnum).name()) +
-                                         " with name \"" + name + "\" found");
+        SmartEnumDetail::Raise<SmartEnumNotFoundException>([&] {
+            return "No " + std::string(SmartEnumDetail::TypeName<TEnum>()) +
+                   " with name \"" + std::string(name) + "\" found";
+        });
     }
     return *result;
 }
 
 template <typename TEnum, typename TValue>
-bool SmartEnum<TEnum, TValue>::TryFromName(const std::string& name, const TEnum*& outResult, bool ignoreCase) {
+bool SmartEnum<TEnum, TValue>::TryFromName(std::string_view name, const TEnum*& outResult, bool ignoreCase) {
     outResult = TryFromNameInternal(name, ignoreCase);
     return outResult != nullptr;
 }
@@ -177,8 +262,10 @@ template <typename TEnum, typename TValue>
 const TEnum& SmartEnum<TEnum, TValue>::FromValue(const ValueType& value) {
     const TEnum* result = nullptr;
     if (!TryFromValue(value, result)) {
-        throw SmartEnumNotFoundException("No " + std::string(typeid(TEnum).name()) +
-                                         " with value \"" + valueToString(value) + "\" found");
+        SmartEnumDetail::Raise<SmartEnumNotFoundException>([&] {
+            return "No " + std::string(SmartEnumDetail::TypeName<TEnum>()) +
+                   " with value \"" + valueToString(value) + "\" found";
+        });
     }
     return *result;
 }
@@ -190,86 +277,43 @@ bool SmartEnum<TEnum, TValue>::TryFromValue(const ValueType& value, const TEnum*
 }
 
 template <typename TEnum, typename TValue>
-SmartEnum<TEnum, TValue>::SmartEnum(const std::string& name, const ValueType& value) : name_(name), value_(value) {
+SmartEnum<TEnum, TValue>::SmartEnum(const std::string& name, const ValueType& value) : name_(name), value_(value), ordinal_(0) {
     if (name.empty()) {
-        throw std::invalid_argument("SmartEnum name cannot be empty");
+        SmartEnumDetail::Raise<std::invalid_argument>([] { return "SmartEnum name cannot be empty"; });
     }
-    registerInstance(static_cast<const TEnum*>(this));
+    // The ordinal is written under the registry lock, before other threads can see the instance
+    registerInstance(static_cast<const TEnum*>(this), ordinal_);
 }
 
 template <typename TEnum, typename TValue>
-std::vector<const TEnum*>& SmartEnum<TEnum, TValue>::instances() {
-    static std::vector<const TEnum*> instanceList;
-    return instanceList;
+typename SmartEnum<TEnum, TValue>::Registry& SmartEnum<TEnum, TValue>::registry() {
+    static Registry r;
+    return r;
 }
 
-template <typename TEnum, typename TValue>
-std::map<std::string, const TEnum*>& SmartEnum<TEnum, TValue>::nameMap() {
-    static std::map<std::string, const TEnum*> m;
-    return m;
-}
-
-template <typename TEnum, typename TValue>
-std::map<std::string, const TEnum*>& SmartEnum<TEnum, TValue>::nameMapIgnoreCase() {
-    static std::map<std::string, const TEnum*> m;
-    return m;
-}
-
-template <typename TEnum, typename TValue>
-std::map<typename SmartEnum<TEnum, TValue>::ValueType, const TEnum*>& SmartEnum<TEnum, TValue>::valueMap() {
-    static std::map<ValueType, const TEnum*> m;
-    return m;
-}
-
-template <typename TEnum, typename TValue>
-std::once_flag SmartEnum<TEnum, TValue>::listInitFlag_;
-
 template <typename TEnum, typename TValue>
 std::string SmartEnum<TEnum, TValue>::valueToString(const ValueType& val) {
     return std::to_string(static_cast<long long>(val));
 }
 
 template <typename TEnum, typename TValue>
-void SmartEnum<TEnum, TValue>::registerInstance(const TEnum* instance) {
-    if (!instance) return;
-    
-    const std::string& nm = instance->Name();
-    if (nameMap().count(nm)) {
-        throw std::runtime_error("Duplicate SmartEnum name \"" + nm + "\"");
-    }
-    
-    instances().push_back(instance);
-    nameMap()[nm] = instance;
-    
-    std::string lower = nm;
-    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-    if (!nameMapIgnoreCase().count(lower)) {
-        nameMapIgnoreCase()[lower] = instance;
-    }
-    
-    const ValueType& val = instance->Value();
-    if (!valueMap().count(val)) {
-        valueMap()[val] = instance;
+void SmartEnum<TEnum, TValue>::registerInstance(const TEnum* instance, std::size_t& outOrdinal) {
+    if (!registry().Register(instance, outOrdinal)) {
+        SmartEnumDetail::Raise<std::runtime_error>([instance] {
+            return "Duplicate SmartEnum name \"" + instance->Name() + "\"";
+        });
     }
 }
 
 template <typename TEnum, typename TValue>
-const TEnum* SmartEnum<TEnum, TValue>::TryFromNameInternal(const std::string& name, bool ignoreCase) {
-    if (ignoreCase) {
-        std::string lower = name;
-        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-        auto it = nameMapIgnoreCase().find(lower);
-        return it != nameMapIgnoreCase().end() ? it->second : nullptr;
-    } else {
-        auto it = nameMap().find(name);
-        return it != nameMap().end() ? it->second : nullptr;
-    }
+const TEnum* SmartEnum<TEnum, TValue>::TryFromNameInternal(std::string_view name, bool ignoreCase) {
+    const auto& index = registry().Lookup();
+    return ignoreCase ? index.FindNameIgnoreCase(name) : index.FindName(name);
 }
 
 template <typename TEnum, typename TValue>
 const TEnum* SmartEnum<TEnum, TValue>::TryFromValueInternal(const ValueType& value) {
-    auto it = valueMap().find(value);
-    return it != valueMap().end() ? it->second : nullptr;
+    return registry().Lookup().FindValue(value);
 }
 
 #endif // SMARTENUM_HPP
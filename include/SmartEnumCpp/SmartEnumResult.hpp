@@ -0,0 +1,157 @@
+/**
+ * @file SmartEnumResult.hpp
+ * @brief Error codes and the expected-style result returned by the Find* lookups.
+ *
+ * The Find* functions of SmartEnum, SmartFlagEnum and ConstexprSmartEnum never
+ * throw and never allocate when a lookup misses; they return a
+ * SmartEnumResult holding either the match or a SmartEnumErrc.
+ *
+ * Example:
+ * @code
+ * if (auto color = Color::FindName(token)) {
+ *     paint(*color);
+ * } else if (color.Error() == SmartEnumErrc::NameNotFound) {
+ *     log("unknown color");
+ * }
+ * @endcode
+ */
+
+#ifndef SMARTENUMRESULT_HPP
+#define SMARTENUMRESULT_HPP
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "detail/Config.hpp"
+
+/**
+ * @brief Reasons a Find* lookup can fail.
+ */
+enum class SmartEnumErrc {
+    None = 0,           ///< The lookup succeeded.
+    NameNotFound,       ///< No instance has the given name.
+    ValueNotFound,      ///< No instance has the given value.
+    InvalidFlagValue,   ///< The value cannot be expressed with the defined flags.
+    NegativeFlagValue,  ///< A negative value did not match any flag exactly.
+};
+
+/**
+ * @brief Returns a static description of @p errc; never allocates.
+ */
+constexpr const char* ToString(SmartEnumErrc errc) {
+    switch (errc) {
+    case SmartEnumErrc::None: return "success";
+    case SmartEnumErrc::NameNotFound: return "name not found";
+    case SmartEnumErrc::ValueNotFound: return "value not found";
+    case SmartEnumErrc::InvalidFlagValue: return "value is not a valid flag combination";
+    case SmartEnumErrc::NegativeFlagValue: return "negative flag value not allowed";
+    }
+    return "unknown error";
+}
+
+/**
+ * @brief Exception thrown when Value() is called on a failed SmartEnumResult.
+ */
+class SmartEnumBadResultAccess : public std::logic_error {
+public:
+    explicit SmartEnumBadResultAccess(const std::string& message) : std::logic_error(message) {}
+};
+
+/**
+ * @brief Holds either a lookup result of type T or the SmartEnumErrc explaining the miss.
+ *
+ * @tparam T The result type; may be a reference (`const TEnum&`), in which case
+ *           only a pointer is stored.
+ */
+template <typename T>
+class SmartEnumResult {
+public:
+    SmartEnumResult(T value) : value_(std::move(value)), error_(SmartEnumErrc::None) {}
+    SmartEnumResult(SmartEnumErrc error) : error_(error) {}
+
+    bool HasValue() const { return value_.has_value(); }
+    explicit operator bool() const { return HasValue(); }
+
+    /**
+     * @brief Returns the error code, SmartEnumErrc::None on success.
+     */
+    SmartEnumErrc Error() const { return error_; }
+
+    /**
+     * @brief Returns the result.
+     * @throws SmartEnumBadResultAccess if the lookup failed.
+     */
+    const T& Value() const& { check(); return *value_; }
+    T& Value() & { check(); return *value_; }
+    T&& Value() && { check(); return std::move(*value_); }
+
+    /**
+     * @brief Returns the result, or @p fallback if the lookup failed.
+     */
+    T ValueOr(T fallback) const& { return HasValue() ? *value_ : std::move(fallback); }
+
+    const T& operator*() const& { return *value_; }
+    T& operator*() & { return *value_; }
+    const T* operator->() const { return &*value_; }
+    T* operator->() { return &*value_; }
+
+private:
+    void check() const {
+        if (!HasValue()) {
+            SmartEnumDetail::Raise<SmartEnumBadResultAccess>([this] { return std::string(ToString(error_)); });
+        }
+    }
+
+    std::optional<T> value_;
+    SmartEnumErrc error_;
+};
+
+/**
+ * @brief Reference specialization: stores a pointer to the matched instance.
+ */
+template <typename T>
+class SmartEnumResult<T&> {
+public:
+    constexpr SmartEnumResult(T& value) : value_(&value), error_(SmartEnumErrc::None) {}
+    constexpr SmartEnumResult(SmartEnumErrc error) : value_(nullptr), error_(error) {}
+
+    constexpr bool HasValue() const { return value_ != nullptr; }
+    constexpr explicit operator bool() const { return HasValue(); }
+
+    /**
+     * @brief Returns the error code, SmartEnumErrc::None on success.
+     */
+    constexpr SmartEnumErrc Error() const { return error_; }
+
+    /**
+     * @brief Returns the matched instance.
+     * @throws SmartEnumBadResultAccess if the lookup failed.
+     */
+    constexpr T& Value() const {
+        if (!HasValue()) {
+            SmartEnumDetail::Raise<SmartEnumBadResultAccess>([this] { return std::string(ToString(error_)); });
+        }
+        return *value_;
+    }
+
+    /**
+     * @brief Returns the matched instance, or @p fallback if the lookup failed.
+     */
+    constexpr T& ValueOr(T& fallback) const { return HasValue() ? *value_ : fallback; }
+
+    /**
+     * @brief Returns a pointer to the matched instance, or nullptr.
+     */
+    constexpr T* Get() const { return value_; }
+
+    constexpr T& operator*() const { return *value_; }
+    constexpr T* operator->() const { return value_; }
+
+private:
+    T* value_;
+    SmartEnumErrc error_;
+};
+
+#endif // SMARTENUMRESULT_HPP
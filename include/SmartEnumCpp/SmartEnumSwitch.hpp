@@ -12,12 +12,86 @@
  *   .When(MyEnum::Two).Then([](){ ... })
  *   .Default([](){ ... });
  * @endcode
+ *
+ * Actions are taken as template parameters and called directly, so no
+ * std::function is constructed and the whole chain inlines into a sequence of
+ * compares and branches.
+ *
+ * A single-candidate When() compares values, so an alias matches the
+ * instance it shares a value with. A case may also name several instances,
+ * compared in turn by identity (Ordinal()), or an EnumSet, tested with one bit
+ * test (build the set once, e.g. as a static const); flag values can be
+ * matched on any or all bits:
+ * @code
+ * SwitchOn(status)
+ *   .When(Status::Shipped, Status::Delivered).Then([](){ ... })
+ *   .When(kOpenStatuses).Then([](){ ... });          // EnumSet<Status>
+ *
+ * SwitchOn(permissions)                               // FlagSet or flag instance
+ *   .WhenFlags(Permission::Write).Then([](){ ... })   // any of the bits
+ *   .WhenFlags(Permission::ReadWrite, FlagMatch::All).Then([](){ ... });
+ * @endcode
+ *
+ * Match<R>() is the value-returning form:
+ * @code
+ * const char* label = Match<const char*>(myEnum)
+ *   .When(MyEnum::One, [] { return "one"; })
+ *   .When(MyEnum::Two, [] { return "two"; })
+ *   .Otherwise([] { return "other"; });
+ * @endcode
  */
 
 #ifndef SMARTENUMSWITCH_HPP
 #define SMARTENUMSWITCH_HPP
 
-#include <functional>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "EnumSet.hpp"
+
+/**
+ * @brief How WhenFlags() compares the switched value with the given flags.
+ */
+enum class FlagMatch {
+    Any,  ///< at least one of the flags' bits is set
+    All   ///< every one of the flags' bits is set
+};
+
+namespace SmartEnumDetail {
+
+template<typename T, typename = void>
+struct HasValueMember : std::false_type {};
+
+template<typename T>
+struct HasValueMember<T, std::void_t<decltype(std::declval<const T&>().Value())>> : std::true_type {};
+
+/**
+ * @brief Bits of a flag instance or FlagSet (its Value()), or of a plain value.
+ */
+template<typename T>
+constexpr auto FlagBitsOf(const T& flags) {
+    if constexpr (HasValueMember<T>::value) {
+        return flags.Value();
+    } else {
+        return flags;
+    }
+}
+
+/**
+ * @brief Tests @p value against @p flags; integral bits or FlagBitset.
+ */
+template<typename TBits>
+constexpr bool MatchFlagBits(const TBits& value, const TBits& flags, FlagMatch match) {
+    if constexpr (std::is_integral<TBits>::value) {
+        const TBits common = static_cast<TBits>(value & flags);
+        return match == FlagMatch::All ? common == flags : common != 0;
+    } else {
+        return match == FlagMatch::All ? value.HasAll(flags) : value.HasAny(flags);
+    }
+}
+
+} // namespace SmartEnumDetail
 
 template<typename EnumType>
 class SmartEnumSwitchBuilder {
@@ -41,12 +115,58 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Checks if the enum is any of the candidate instances.
+     *
+     * The candidates' ordinals are compared in order, stopping at the first
+     * match, so instances are matched by identity rather than by Value(). For
+     * a group that is tested often, a prebuilt EnumSet is one bit test instead
+     * of one compare per candidate.
+     */
+    template<typename... TRest>
+    inline SmartEnumSwitchBuilder& When(const EnumType& first, const EnumType& second, const TRest&... rest) {
+        static_assert((std::is_base_of<EnumType, TRest>::value && ...), "When candidates must be instances of the enum");
+        const std::size_t ordinal = value_.Ordinal();
+        lastMatch_ = !handled_ && (ordinal == first.Ordinal() || ordinal == second.Ordinal() ||
+                                   ((ordinal == static_cast<const EnumType&>(rest).Ordinal()) || ...));
+        return *this;
+    }
+
+    /**
+     * @brief Checks if the enum is a member of @p members (one bit test).
+     *
+     * The set is not copied; declaring it once, e.g. as a static const, keeps
+     * its mask from being rebuilt on every evaluation.
+     */
+    template<std::size_t Capacity>
+    inline SmartEnumSwitchBuilder& When(const EnumSet<EnumType, Capacity>& members) {
+        lastMatch_ = !handled_ && members.Contains(value_);
+        return *this;
+    }
+
+    /**
+     * @brief Checks the switched flag value against the bits of @p flags.
+     *
+     * @p flags may be a flag instance, a FlagSet or a raw value. With
+     * FlagMatch::Any the case matches if any of its bits is set, with
+     * FlagMatch::All only if all of them are.
+     */
+    template<typename TFlags>
+    inline SmartEnumSwitchBuilder& WhenFlags(const TFlags& flags, FlagMatch match = FlagMatch::Any) {
+        using Bits = decltype(SmartEnumDetail::FlagBitsOf(value_));
+        lastMatch_ = !handled_ &&
+                     SmartEnumDetail::MatchFlagBits<Bits>(SmartEnumDetail::FlagBitsOf(value_),
+                                                          static_cast<Bits>(SmartEnumDetail::FlagBitsOf(flags)), match);
+        return *this;
+    }
+
     /**
      * @brief Executes the action if the previous When() matched.
      */
-    inline SmartEnumSwitchBuilder& Then(const std::function<void()>& action) {
+    template<typename TAction>
+    inline SmartEnumSwitchBuilder& Then(TAction&& action) {
         if (!handled_ && lastMatch_) {
-            action();
+            std::forward<TAction>(action)();
             handled_ = true;
         }
         lastMatch_ = false;
@@ -56,9 +176,10 @@ public:
     /**
      * @brief Executes the default action if no case was handled.
      */
-    inline void Default(const std::function<void()>& action) {
+    template<typename TAction>
+    inline void Default(TAction&& action) {
         if (!handled_) {
-            action();
+            std::forward<TAction>(action)();
         }
     }
 private:
@@ -75,4 +196,119 @@ inline SmartEnumSwitchBuilder<EnumType> SwitchOn(const EnumType& enumValue) {
     return SmartEnumSwitchBuilder<EnumType>(enumValue);
 }
 
+template<typename R, typename EnumType, typename TPrevious, typename TAction>
+class SmartEnumMatchCase;
+
+/**
+ * @brief Common interface of a Match() expression and its cases.
+ *
+ * Each When() returns a new expression type that holds the previous one and
+ * the action by value; nothing is evaluated until Otherwise(), which tests
+ * the cases in order and returns the first match's result. Everything is
+ * constexpr, so a match over constexpr instances (e.g. ConstexprSmartEnum)
+ * with constexpr-callable lambdas is a constant expression.
+ */
+template<typename R, typename EnumType, typename TDerived>
+class SmartEnumMatchExpression {
+public:
+    /**
+     * @brief Adds a case: yields action() if the value equals @p candidate.
+     */
+    template<typename TAction>
+    constexpr SmartEnumMatchCase<R, EnumType, TDerived, std::decay_t<TAction>>
+    When(const EnumType& candidate, TAction&& action) const& {
+        checkAction<TAction>();
+        return {self(), candidate, std::forward<TAction>(action)};
+    }
+
+    template<typename TAction>
+    constexpr SmartEnumMatchCase<R, EnumType, TDerived, std::decay_t<TAction>>
+    When(const EnumType& candidate, TAction&& action) && {
+        checkAction<TAction>();
+        return {std::move(static_cast<TDerived&>(*this)), candidate, std::forward<TAction>(action)};
+    }
+
+    /**
+     * @brief Evaluates the cases in order; yields fallback() if none matched.
+     */
+    template<typename TFallback>
+    constexpr R Otherwise(TFallback&& fallback) const {
+        return self().resolve([&fallback]() -> R { return fallback(); });
+    }
+
+private:
+    template<typename TAction>
+    static constexpr void checkAction() {
+        static_assert(std::is_convertible<std::invoke_result_t<const std::decay_t<TAction>&>, R>::value,
+                      "Match case action must be const-callable and return a value convertible to R");
+    }
+
+    constexpr const TDerived& self() const { return static_cast<const TDerived&>(*this); }
+};
+
+/**
+ * @brief Match() expression with no case yet.
+ */
+template<typename R, typename EnumType>
+class SmartEnumMatch : public SmartEnumMatchExpression<R, EnumType, SmartEnumMatch<R, EnumType>> {
+public:
+    constexpr explicit SmartEnumMatch(const EnumType& value) : value_(value) {}
+
+    constexpr const EnumType& Value() const { return value_; }
+
+private:
+    template<typename, typename, typename>
+    friend class SmartEnumMatchExpression;
+    template<typename, typename, typename, typename>
+    friend class SmartEnumMatchCase;
+
+    template<typename TNext>
+    constexpr R resolve(const TNext& next) const { return next(); }
+
+    const EnumType& value_;
+};
+
+/**
+ * @brief Match() expression ending with the case (candidate_, action_).
+ */
+template<typename R, typename EnumType, typename TPrevious, typename TAction>
+class SmartEnumMatchCase
+    : public SmartEnumMatchExpression<R, EnumType, SmartEnumMatchCase<R, EnumType, TPrevious, TAction>> {
+public:
+    constexpr SmartEnumMatchCase(TPrevious previous, const EnumType& candidate, TAction action)
+        : previous_(std::move(previous)), candidate_(candidate), action_(std::move(action)) {}
+
+    constexpr const EnumType& Value() const { return previous_.Value(); }
+
+private:
+    template<typename, typename, typename>
+    friend class SmartEnumMatchExpression;
+    template<typename, typename, typename, typename>
+    friend class SmartEnumMatchCase;
+
+    /**
+     * @brief Earlier cases are tried first; this one is tried only if they all miss.
+     */
+    template<typename TNext>
+    constexpr R resolve(const TNext& next) const {
+        return previous_.resolve([this, &next]() -> R {
+            return Value() == candidate_ ? static_cast<R>(action_()) : next();
+        });
+    }
+
+    TPrevious previous_;
+    const EnumType& candidate_;
+    TAction action_;
+};
+
+/**
+ * @brief Starts a value-returning match on the given enum value.
+ *
+ * @tparam R The result type of every case.
+ */
+template<typename R, typename EnumType>
+constexpr SmartEnumMatch<R, EnumType> Match(const EnumType& enumValue) {
+    return SmartEnumMatch<R, EnumType>(enumValue);
+}
+
 #endif // SMARTENUMSWITCH_HPP
@@ -12,12 +12,16 @@
 
 #include <vector>
 #include <algorithm>
-#include <map>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
-#include <cctype>
-#include <typeinfo>
+#include <utility>
+
+#include "FlagSet.hpp"
+#include "SmartEnumResult.hpp"
+#include "detail/FlagBitRange.hpp"
+#include "detail/Registry.hpp"
 
 // Marker types to modify behavior of flag enums.
 struct AllowNegativeFlagEnumInput
@@ -26,6 +30,39 @@ struct AllowNegativeFlagEnumInput
 struct AllowUnsafeFlagEnumValues
 {
 };
+// UseFlagEnumLookupTable (detail/FlagLookupTable.hpp) opts narrow flag enums into a full decode table.
+
+namespace SmartEnumDetail
+{
+/**
+ * @brief True if TEnum may define negative flag values such as -1 for "All".
+ */
+template <typename TEnum>
+struct AllowsNegativeFlags : std::is_base_of<AllowNegativeFlagEnumInput, TEnum>
+{
+};
+
+/**
+ * @brief True if TEnum may define flag values other than 0 and single bits.
+ */
+template <typename TEnum>
+struct AllowsUnsafeFlags : std::is_base_of<AllowUnsafeFlagEnumValues, TEnum>
+{
+};
+
+template <typename TValue>
+constexpr bool IsNegativeFlagValue(TValue value)
+{
+    if constexpr (std::is_signed<TValue>::value)
+    {
+        return value < 0;
+    }
+    else
+    {
+        return false;
+    }
+}
+} // namespace SmartEnumDetail
 
 /**
  * @brief Exception for invalid flag enum parsing.
@@ -36,7 +73,7 @@ public:
     explicit InvalidFlagEnumValueParseException(const std::string &msg) : std::runtime_error(msg) {}
 };
 /**
- * @brief Exception for negative flag input when not allowed.
+ * @brief Exception for a negative flag definition on a type without AllowNegativeFlagEnumInput.
  */
 class NegativeFlagValueNotAllowedException : public std::runtime_error
 {
@@ -45,6 +82,8 @@ public:
 };
 /**
  * @brief Exception when flag definitions do not follow required power-of-two rules.
+ *
+ * Kept for compatibility; the rule is now checked at compile time by SmartFlagEnum::Flag().
  */
 class SmartFlagEnumNotPowerOfTwoException : public std::runtime_error
 {
@@ -56,17 +95,19 @@ public:
  * @brief Base template for creating flag (bitfield) SmartEnums.
  *
  * @tparam TEnum The derived flag enum type.
- * @tparam TValue The underlying integral type (default is int).
+ * @tparam TValue The underlying integral type (default is int). For more than
+ *                64 flags use FlagBitset<Bits>, see detail/WideSmartFlagEnum.hpp.
  */
 template <typename TEnum, typename TValue = int>
 class SmartFlagEnum
 {
     static_assert(std::is_integral<TValue>::value || std::is_enum<TValue>::value,
-                  "SmartFlagEnum requires an integral underlying type");
+                  "SmartFlagEnum requires an integral underlying type or a FlagBitset");
 
 public:
     using ValueType = TValue;
     using EnumType = TEnum;
+    using DecomposeRange = SmartEnumDetail::FlagBitRange<TEnum, TValue>;
 
     SmartFlagEnum(const SmartFlagEnum &) = delete;
     SmartFlagEnum &operator=(const SmartFlagEnum &) = delete;
@@ -79,7 +120,14 @@ public:
     /**
      * @brief Gets the flag instance's underlying value.
      */
-    inline const ValueType &Value() const { return value_; }
+    constexpr const ValueType &Value() const { return value_; }
+
+    /**
+     * @brief Gets the zero-based registration position of the flag instance.
+     *
+     * Ordinals are dense (0..Count()-1) and match the instance's index in List().
+     */
+    inline std::size_t Ordinal() const { return ordinal_; }
 
     /**
      * @brief Converts this flag instance to its string representation.
@@ -94,28 +142,112 @@ public:
      */
     inline operator TValue() const { return value_; }
     /**
-     * @brief Returns a list of all flag instances.
+     * @brief Checks a flag definition at compile time and returns @p V.
+     *
+     * @code
+     * const Permission Permission::Read("Read", Flag<1>());
+     * const Permission Permission::ReadWrite("ReadWrite", Flag<1>() | Flag<2>());
+     * @endcode
+     *
+     * V must be 0 or a single bit. Negative values need AllowNegativeFlagEnumInput
+     * and other multi-bit values need AllowUnsafeFlagEnumValues; combinations of
+     * checked flags, as above, need neither.
      */
-    static const std::vector<const TEnum *> &List()
+    template <TValue V>
+    static constexpr TValue Flag()
     {
-        enforceFlagDefinitions();
-        return instances();
+        static_assert(!SmartEnumDetail::IsNegativeFlagValue(V) || SmartEnumDetail::AllowsNegativeFlags<TEnum>::value,
+                      "negative flag values need AllowNegativeFlagEnumInput");
+        static_assert(SmartEnumDetail::IsNegativeFlagValue(V) || V == 0 || isPowerOfTwo(V) ||
+                          SmartEnumDetail::AllowsUnsafeFlags<TEnum>::value,
+                      "flag values must be 0 or a power of two; derive from AllowUnsafeFlagEnumValues to allow others");
+        return V;
     }
 
     /**
-     * @brief Returns flag instances by a comma-separated list of names.
+     * @brief Returns a list of all flag instances.
+     */
+    static const std::vector<const TEnum *> &List() { return registry().Lookup().instances; }
+
+    /**
+     * @brief Compacts the lookup indexes into flat sorted arrays.
+     *
+     * Lookups freeze automatically the first time they run; see SmartEnum::Freeze().
+     */
+    static void Freeze() { registry().Freeze(); }
+
+    /**
+     * @brief Returns the number of defined flag instances.
+     */
+    static std::size_t Count() { return registry().Size(); }
+
+    /**
+     * @brief Returns flag instances by a list of names separated by ',' or '|'.
      *
-     * @param names Comma-separated flag names.
+     * @param names Flag names separated by ',' or '|'.
      * @param ignoreCase If true, the lookup is case-insensitive.
      * @return A vector of matching flag instances.
      * @throws SmartEnumNotFoundException if any name is not found.
      */
-    static std::vector<const TEnum *> FromName(const std::string &names, bool ignoreCase = false);
+    static std::vector<const TEnum *> FromName(std::string_view names, bool ignoreCase = false);
+
+    /**
+     * @brief Returns flag instances by names given as pointer and length.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static std::vector<const TEnum *> FromName(const char *names, TSize length, bool ignoreCase = false)
+    {
+        return FromName(std::string_view(names, static_cast<std::size_t>(length)), ignoreCase);
+    }
+
+    /**
+     * @brief Tries to parse flag names separated by ',' or '|'.
+     */
+    static bool TryFromName(std::string_view names, std::vector<const TEnum *> &outResult, bool ignoreCase = false);
 
     /**
-     * @brief Tries to parse comma-separated flag names.
+     * @brief Tries to parse flag names separated by ',' or '|' into a combined value.
+     *
+     * Tokens are trimmed views into @p names and are OR'ed straight into the
+     * result, so nothing is allocated. @p outValue is only written on success.
      */
-    static bool TryFromName(const std::string &names, std::vector<const TEnum *> &outResult, bool ignoreCase = false);
+    static bool TryFromName(std::string_view names, ValueType &outValue, bool ignoreCase = false)
+    {
+        ValueType mask = 0;
+        const auto accumulate = [&mask](const TEnum *flag) { mask = static_cast<ValueType>(mask | flag->Value()); };
+        if (parseNames(names, ignoreCase, accumulate) != SmartEnumErrc::None)
+        {
+            return false;
+        }
+        outValue = mask;
+        return true;
+    }
+
+    /**
+     * @brief Tries to parse flag names separated by ',' or '|' into a FlagSet.
+     */
+    static bool TryFromName(std::string_view names, FlagSet<TEnum> &outFlags, bool ignoreCase = false)
+    {
+        ValueType mask = 0;
+        if (!TryFromName(names, mask, ignoreCase))
+        {
+            return false;
+        }
+        outFlags = FlagSet<TEnum>(mask);
+        return true;
+    }
+
+    /**
+     * @brief Tries to parse flag names given as pointer and length.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static bool TryFromName(const char *names, TSize length, std::vector<const TEnum *> &outResult,
+                            bool ignoreCase = false)
+    {
+        return TryFromName(std::string_view(names, static_cast<std::size_t>(length)), outResult, ignoreCase);
+    }
 
     /**
      * @brief Returns flag instances corresponding to a combined value.
@@ -135,8 +267,27 @@ public:
      */
     static bool TryFromValue(const ValueType &value, std::vector<const TEnum *> &outResult);
 
+    /**
+     * @brief Iterates the single-bit flags set in a value, lowest bit first.
+     *
+     * Nothing is allocated and a full pass costs O(popcount). Bits that have no
+     * single-bit flag are skipped and reported by UnmatchedBits():
+     * @code
+     * for (const Permission &p : Permission::Decompose(mask)) { ... }
+     * @endcode
+     */
+    static DecomposeRange Decompose(const ValueType &value)
+    {
+        const auto &index = registry().Lookup();
+        return DecomposeRange(value, index.flagByBit.data(),
+                              static_cast<typename DecomposeRange::Bits>(index.singleBitFlags));
+    }
+
     /**
      * @brief Converts a combined flag value into a comma-separated string of flag names.
+     *
+     * Lists the flags FromValue() returns, in the same order: an exact match
+     * prints as that flag's name, anything else as its largest flags first.
      */
     static std::string FromValueToString(const ValueType &value);
 
@@ -145,6 +296,69 @@ public:
      */
     static bool TryFromValueToString(const ValueType &value, std::string &outStr);
 
+    /**
+     * @brief Parses flag names separated by ',' or '|' without throwing.
+     *
+     * Every name is resolved before the result vector is built, so a miss
+     * never allocates.
+     *
+     * @return The matching flag instances, or SmartEnumErrc::NameNotFound.
+     */
+    static SmartEnumResult<std::vector<const TEnum *>> FindName(std::string_view names, bool ignoreCase = false)
+    {
+        const SmartEnumErrc error = parseNames(names, ignoreCase, [](const TEnum *) {});
+        if (error != SmartEnumErrc::None)
+        {
+            return error;
+        }
+        std::vector<const TEnum *> result;
+        parseNames(names, ignoreCase, [&result](const TEnum *flag) { result.push_back(flag); });
+        return result;
+    }
+
+    /**
+     * @brief Parses flag names given as pointer and length, without throwing.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static SmartEnumResult<std::vector<const TEnum *>> FindName(const char *names, TSize length,
+                                                                bool ignoreCase = false)
+    {
+        return FindName(std::string_view(names, static_cast<std::size_t>(length)), ignoreCase);
+    }
+
+    /**
+     * @brief Interprets a combined flag value without throwing.
+     *
+     * @return The flag instances, or SmartEnumErrc::NegativeFlagValue /
+     *         SmartEnumErrc::InvalidFlagValue.
+     */
+    static SmartEnumResult<std::vector<const TEnum *>> FindValue(const ValueType &value)
+    {
+        const SmartEnumErrc error = decodeValue(value, nullptr);
+        if (error != SmartEnumErrc::None)
+        {
+            return error;
+        }
+        std::vector<const TEnum *> result;
+        decodeValue(value, &result);
+        return result;
+    }
+
+    /**
+     * @brief Converts a combined flag value into a comma-separated string without throwing.
+     */
+    static SmartEnumResult<std::string> FindValueToString(const ValueType &value)
+    {
+        std::string result;
+        const SmartEnumErrc error = formatValue(value, result);
+        if (error != SmartEnumErrc::None)
+        {
+            return error;
+        }
+        return result;
+    }
+
 protected:
     /**
      * @brief Protected constructor. Registers the flag instance.
@@ -158,80 +372,81 @@ protected:
 private:
     std::string name_;
     ValueType value_;
+    std::size_t ordinal_;
+
+    using Registry = SmartEnumDetail::Registry<TEnum, ValueType>;
+
+    static Registry &registry();
 
-    static std::vector<const TEnum *> &instances();
-    static std::map<std::string, const TEnum *> &nameMap();
-    static std::map<std::string, const TEnum *> &nameMapIgnoreCase();
-    static std::map<ValueType, const TEnum *> &valueMap();
-    static bool &definitionsValidated();
-
-    static void registerInstance(const TEnum *instance);
-    static void enforceFlagDefinitions();
-    static const TEnum *findByName(const std::string &name);
-    static const TEnum *findByNameCaseInsensitive(const std::string &name);
-    static inline bool isPowerOfTwo(ValueType v) { return v > 0 && (v & (v - 1)) == 0; }
-    static bool fitsInDefinedFlags(ValueType input);
+    static void registerInstance(const TEnum *instance, std::size_t &outOrdinal);
+    template <typename TOnFlag>
+    static SmartEnumErrc parseNames(std::string_view names, bool ignoreCase, TOnFlag &&onFlag);
+    static SmartEnumErrc decodeValue(const ValueType &value, std::vector<const TEnum *> *outResult);
+    static SmartEnumErrc formatValue(const ValueType &value, std::string &outStr);
+    static constexpr bool isPowerOfTwo(ValueType v) { return v > 0 && (v & (v - 1)) == 0; }
 };
 
+/**
+ * @brief Combining two flag instances yields a typed FlagSet, which still converts to TValue.
+ */
+template <typename TEnum, typename TValue,
+          typename = std::enable_if_t<std::is_integral<TValue>::value>>
+inline FlagSet<TEnum> operator|(const SmartFlagEnum<TEnum, TValue> &a, const SmartFlagEnum<TEnum, TValue> &b)
+{
+    return FlagSet<TEnum>(static_cast<TValue>(a.Value() | b.Value()));
+}
+
 template <typename TEnum, typename TValue,
           typename = std::enable_if_t<std::is_integral<TValue>::value>>
-inline TValue operator|(const SmartFlagEnum<TEnum, TValue> &a, const SmartFlagEnum<TEnum, TValue> &b)
+inline FlagSet<TEnum> operator&(const SmartFlagEnum<TEnum, TValue> &a, const SmartFlagEnum<TEnum, TValue> &b)
 {
-    return static_cast<TValue>(a.Value() | b.Value());
+    return FlagSet<TEnum>(static_cast<TValue>(a.Value() & b.Value()));
+}
+
+template <typename TEnum, typename TValue,
+          typename = std::enable_if_t<std::is_integral<TValue>::value>>
+inline FlagSet<TEnum> operator^(const SmartFlagEnum<TEnum, TValue> &a, const SmartFlagEnum<TEnum, TValue> &b)
+{
+    return FlagSet<TEnum>(static_cast<TValue>(a.Value() ^ b.Value()));
+}
+
+template <typename TEnum, typename TValue,
+          typename = std::enable_if_t<std::is_integral<TValue>::value>>
+inline FlagSet<TEnum> operator~(const SmartFlagEnum<TEnum, TValue> &a)
+{
+    return FlagSet<TEnum>(static_cast<TValue>(~a.Value()));
 }
 
 // Template implementations for SmartFlagEnum
 template <typename TEnum, typename TValue>
-std::vector<const TEnum *> SmartFlagEnum<TEnum, TValue>::FromName(const std::string &names, bool ignoreCase)
+std::vector<const TEnum *> SmartFlagEnum<TEnum, TValue>::FromName(std::string_view names, bool ignoreCase)
 {
     std::vector<const TEnum *> result;
     if (!TryFromName(names, result, ignoreCase))
     {
-        throw InvalidFlagEnumValueParseException(
-            "Failed to parse one or more flags in \"" + names + "\" for type " + std::string(typeid(TEnum).name()));
+        SmartEnumDetail::Raise<InvalidFlagEnumValueParseException>([&]
+        {
+            return "Failed to parse one or more flags in \"" + std::string(names) + "\" for type " +
+                   std::string(SmartEnumDetail::TypeName<TEnum>());
+        });
     }
     return result;
 }
 
 template <typename TEnum, typename TValue>
 bool SmartFlagEnum<TEnum, TValue>::TryFromName(
-    const std::string &names, std::vector<const TEnum *> &outResult, bool ignoreCase)
+    std::string_view names, std::vector<const TEnum *> &outResult, bool ignoreCase)
 {
-
     outResult.clear();
-    if (names.empty())
-    {
-        return true;
-    }
-
-    size_t start = 0;
-    size_t end;
-
-    do
-    {
-        end = names.find(",", start);
-        std::string part = names.substr(start, end == std::string::npos ? end : end - start);
-
-        // Trim whitespace
-        part.erase(0, part.find_first_not_of(" \t"));
-        part.erase(part.find_last_not_of(" \t") + 1);
-
-        if (!part.empty())
-        {
-            const TEnum *foundFlag = ignoreCase ? findByNameCaseInsensitive(part) : findByName(part);
-
-            if (!foundFlag)
-            {
-                return false;
-            }
-
-            outResult.push_back(foundFlag);
-        }
-
-        start = end + 1;
-    } while (end != std::string::npos);
+    return parseNames(names, ignoreCase, [&outResult](const TEnum *flag) { outResult.push_back(flag); }) ==
+           SmartEnumErrc::None;
+}
 
-    return true;
+template <typename TEnum, typename TValue>
+template <typename TOnFlag>
+SmartEnumErrc SmartFlagEnum<TEnum, TValue>::parseNames(std::string_view names, bool ignoreCase, TOnFlag &&onFlag)
+{
+    return SmartEnumDetail::ParseFlagNames(registry().Lookup(), names, ignoreCase, std::forward<TOnFlag>(onFlag));
 }
 
 template <typename TEnum, typename TValue>
@@ -240,9 +455,11 @@ std::vector<const TEnum *> SmartFlagEnum<TEnum, TValue>::FromValue(const ValueTy
     std::vector<const TEnum *> result;
     if (!TryFromValue(value, result))
     {
-        throw InvalidFlagEnumValueParseException(
-            "Value " + std::to_string(static_cast<long long>(value)) +
-            " could not be converted to a valid flag for " + std::string(typeid(TEnum).name()));
+        SmartEnumDetail::Raise<InvalidFlagEnumValueParseException>([&]
+        {
+            return "Value " + std::to_string(static_cast<long long>(value)) +
+                   " could not be converted to a valid flag for " + std::string(SmartEnumDetail::TypeName<TEnum>());
+        });
     }
     return result;
 }
@@ -250,69 +467,24 @@ std::vector<const TEnum *> SmartFlagEnum<TEnum, TValue>::FromValue(const ValueTy
 template <typename TEnum, typename TValue>
 bool SmartFlagEnum<TEnum, TValue>::TryFromValue(const ValueType &value, std::vector<const TEnum *> &outResult)
 {
-    enforceFlagDefinitions();
     outResult.clear();
-
-    // Check if this is an exact match for an existing flag
-    auto it = valueMap().find(value);
-    if (it != valueMap().end())
-    {
-        outResult.push_back(it->second);
-        return true;
-    }
-
-    // Special case for negative values (often used for "All")
-    if (value < 0)
+    if (decodeValue(value, &outResult) != SmartEnumErrc::None)
     {
-        try
-        {
-            using AllowNeg = AllowNegativeFlagEnumInput;
-            AllowNeg *p = nullptr;
-            delete p; // This will fail at runtime - we only use it to trigger linking error
-            // This will never execute - the line above will throw
-            return false;
-        }
-        catch (...)
-        {
-            throw NegativeFlagValueNotAllowedException(
-                "Negative flag value " + std::to_string(static_cast<long long>(value)) +
-                " not allowed for type " + std::string(typeid(TEnum).name()));
-        }
+        outResult.clear();
+        return false;
     }
+    return true;
+}
 
-    // Handle combined flags
-    if (fitsInDefinedFlags(value))
+template <typename TEnum, typename TValue>
+SmartEnumErrc SmartFlagEnum<TEnum, TValue>::decodeValue(const ValueType &value, std::vector<const TEnum *> *outResult)
+{
+    const auto &index = registry().Lookup();
+    if (const auto *table = index.FlagTable())
     {
-        ValueType remainingValue = value;
-        const auto &allFlags = List();
-
-        // Start with the largest value flags and work down
-        std::vector<const TEnum *> sortedFlags = allFlags;
-        std::sort(sortedFlags.begin(), sortedFlags.end(),
-                  [](const TEnum *a, const TEnum *b)
-                  {
-                      return a->Value() > b->Value();
-                  });
-
-        for (const TEnum *flag : sortedFlags)
-        {
-            ValueType flagValue = flag->Value();
-            if ((remainingValue & flagValue) == flagValue)
-            {
-                outResult.push_back(flag);
-                remainingValue &= ~flagValue;
-            }
-
-            if (remainingValue == 0)
-            {
-                break;
-            }
-        }
-
-        return remainingValue == 0;
+        return table->Decode(value, outResult);
     }
-
-    return false;
+    return SmartEnumDetail::DecodeFlagValue(index, value, outResult);
 }
 
 template <typename TEnum, typename TValue>
@@ -321,9 +493,12 @@ std::string SmartFlagEnum<TEnum, TValue>::FromValueToString(const ValueType &val
     std::string result;
     if (!TryFromValueToString(value, result))
     {
-        throw InvalidFlagEnumValueParseException(
-            "Value " + std::to_string(static_cast<long long>(value)) +
-            " could not be converted to a valid flag string for " + std::string(typeid(TEnum).name()));
+        SmartEnumDetail::Raise<InvalidFlagEnumValueParseException>([&]
+        {
+            return "Value " + std::to_string(static_cast<long long>(value)) +
+                   " could not be converted to a valid flag string for " +
+                   std::string(SmartEnumDetail::TypeName<TEnum>());
+        });
     }
     return result;
 }
@@ -331,159 +506,63 @@ std::string SmartFlagEnum<TEnum, TValue>::FromValueToString(const ValueType &val
 template <typename TEnum, typename TValue>
 bool SmartFlagEnum<TEnum, TValue>::TryFromValueToString(const ValueType &value, std::string &outStr)
 {
-    std::vector<const TEnum *> flags;
-    if (!TryFromValue(value, flags))
-    {
-        return false;
-    }
-
-    outStr.clear();
-    for (size_t i = 0; i < flags.size(); ++i)
-    {
-        if (i > 0)
-        {
-            outStr += ", ";
-        }
-        outStr += flags[i]->Name();
-    }
-    return true;
-}
-
-template <typename TEnum, typename TValue>
-SmartFlagEnum<TEnum, TValue>::SmartFlagEnum(const std::string &name, const ValueType &value)
-    : name_(name), value_(value)
-{
-    if (name.empty())
-    {
-        throw std::invalid_argument("SmartFlagEnum name cannot be empty");
-    }
-    registerInstance(static_cast<const TEnum *>(this));
-}
-
-template <typename TEnum, typename TValue>
-std::vector<const TEnum *> &SmartFlagEnum<TEnum, TValue>::instances()
-{
-    static std::vector<const TEnum *> instanceList;
-    return instanceList;
-}
-
-template <typename TEnum, typename TValue>
-std::map<std::string, const TEnum *> &SmartFlagEnum<TEnum, TValue>::nameMap()
-{
-    static std::map<std::string, const TEnum *> m;
-    return m;
-}
-
-template <typename TEnum, typename TValue>
-std::map<std::string, const TEnum *> &SmartFlagEnum<TEnum, TValue>::nameMapIgnoreCase()
-{
-    static std::map<std::string, const TEnum *> m;
-    return m;
-}
-
-template <typename TEnum, typename TValue>
-std::map<typename SmartFlagEnum<TEnum, TValue>::ValueType, const TEnum *> &SmartFlagEnum<TEnum, TValue>::valueMap()
-{
-    static std::map<ValueType, const TEnum *> m;
-    return m;
-}
-
-template <typename TEnum, typename TValue>
-bool &SmartFlagEnum<TEnum, TValue>::definitionsValidated()
-{
-    static bool validated = false;
-    return validated;
+    return formatValue(value, outStr) == SmartEnumErrc::None;
 }
 
 template <typename TEnum, typename TValue>
-void SmartFlagEnum<TEnum, TValue>::registerInstance(const TEnum *instance)
+SmartEnumErrc SmartFlagEnum<TEnum, TValue>::formatValue(const ValueType &value, std::string &outStr)
 {
-    if (!instance)
-        return;
-
-    const std::string &nm = instance->Name();
-    if (nameMap().count(nm))
-    {
-        throw std::runtime_error("Duplicate SmartFlagEnum name \"" + nm + "\"");
-    }
-
-    instances().push_back(instance);
-    nameMap()[nm] = instance;
-
-    std::string lower = nm;
-    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-    if (!nameMapIgnoreCase().count(lower))
-    {
-        nameMapIgnoreCase()[lower] = instance;
-    }
-
-    const ValueType &val = instance->Value();
-    if (!valueMap().count(val))
+    const auto &index = registry().Lookup();
+    if (const auto *table = index.FlagTable())
     {
-        valueMap()[val] = instance;
+        return table->Format(value, outStr);
     }
+    return SmartEnumDetail::FormatFlagValue(index, value, outStr);
 }
 
 template <typename TEnum, typename TValue>
-void SmartFlagEnum<TEnum, TValue>::enforceFlagDefinitions()
+SmartFlagEnum<TEnum, TValue>::SmartFlagEnum(const std::string &name, const ValueType &value)
+    : name_(name), value_(value), ordinal_(0)
 {
-    if (definitionsValidated())
+    if (name.empty())
     {
-        return;
+        SmartEnumDetail::Raise<std::invalid_argument>([] { return "SmartFlagEnum name cannot be empty"; });
     }
-
-    for (const TEnum *instance : instances())
+    // Checked once per definition; types with the marker compile the check out
+    if constexpr (!SmartEnumDetail::AllowsNegativeFlags<TEnum>::value)
     {
-        ValueType value = instance->Value();
-        if (!isPowerOfTwo(value))
+        if (SmartEnumDetail::IsNegativeFlagValue(value))
         {
-            try
+            SmartEnumDetail::Raise<NegativeFlagValueNotAllowedException>([&]
             {
-                using AllowUnsafe = AllowUnsafeFlagEnumValues;
-                AllowUnsafe *p = nullptr;
-                delete p; // This will fail at runtime - trigger linking error
-                break;
-            }
-            catch (...)
-            {
-                throw SmartFlagEnumNotPowerOfTwoException(
-                    "Flag value " + std::to_string(static_cast<long long>(value)) +
-                    " for flag \"" + instance->Name() + "\" is not a power of two");
-            }
+                return "Negative flag value " + std::to_string(static_cast<long long>(value)) + " for \"" + name +
+                       "\" needs AllowNegativeFlagEnumInput on " + std::string(SmartEnumDetail::TypeName<TEnum>());
+            });
         }
     }
-
-    definitionsValidated() = true;
-}
-
-template <typename TEnum, typename TValue>
-const TEnum *SmartFlagEnum<TEnum, TValue>::findByName(const std::string &name)
-{
-    auto it = nameMap().find(name);
-    return it != nameMap().end() ? it->second : nullptr;
+    // The ordinal is written under the registry lock, before other threads can see the instance
+    registerInstance(static_cast<const TEnum *>(this), ordinal_);
 }
 
 template <typename TEnum, typename TValue>
-const TEnum *SmartFlagEnum<TEnum, TValue>::findByNameCaseInsensitive(const std::string &name)
+typename SmartFlagEnum<TEnum, TValue>::Registry &SmartFlagEnum<TEnum, TValue>::registry()
 {
-    std::string lower = name;
-    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-
-    auto it = nameMapIgnoreCase().find(lower);
-    return it != nameMapIgnoreCase().end() ? it->second : nullptr;
+    static Registry r;
+    return r;
 }
 
 template <typename TEnum, typename TValue>
-bool SmartFlagEnum<TEnum, TValue>::fitsInDefinedFlags(ValueType input)
+void SmartFlagEnum<TEnum, TValue>::registerInstance(const TEnum *instance, std::size_t &outOrdinal)
 {
-    ValueType allFlags = 0;
-    for (const TEnum *instance : instances())
+    if (!registry().Register(instance, outOrdinal))
     {
-        allFlags |= instance->Value();
+        SmartEnumDetail::Raise<std::runtime_error>([instance]
+        {
+            return "Duplicate SmartFlagEnum name \"" + instance->Name() + "\"";
+        });
     }
-
-    // Check if input has any bits set that aren't in allFlags
-    return (input & ~allFlags) == 0;
 }
 
+#include "detail/WideSmartFlagEnum.hpp"
+
 #endif // SMARTFLAGENUM_HPP
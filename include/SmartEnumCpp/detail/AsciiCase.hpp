@@ -0,0 +1,135 @@
+/**
+ * @file AsciiCase.hpp
+ * @brief ASCII case-folding comparisons shared by the SmartEnum name indexes.
+ *
+ * Enum names are compared with plain ASCII folding ('A'-'Z' map to 'a'-'z',
+ * every other byte is left alone). No locale is consulted and no folded
+ * copy of the input is ever made: bytes are folded while they are compared,
+ * eight at a time. Everything here is constexpr so the same code serves the
+ * compile-time name tables.
+ */
+
+#ifndef SMARTENUM_DETAIL_ASCIICASE_HPP
+#define SMARTENUM_DETAIL_ASCIICASE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace SmartEnumDetail {
+
+/**
+ * @brief Folds a single ASCII upper-case letter to lower case.
+ */
+constexpr char AsciiToLower(char c) {
+    return static_cast<unsigned char>(c - 'A') < 26 ? static_cast<char>(c | 0x20) : c;
+}
+
+/**
+ * @brief Folds eight packed bytes at once (SWAR).
+ *
+ * A byte gets 0x20 OR'ed in exactly when it lies in 'A'..'Z'. Bytes with the
+ * high bit set (UTF-8 lead and continuation bytes) are never touched.
+ */
+constexpr std::uint64_t AsciiToLower8(std::uint64_t word) {
+    constexpr std::uint64_t kLow7 = 0x7f7f7f7f7f7f7f7fULL;
+    constexpr std::uint64_t kHigh = 0x8080808080808080ULL;
+    const std::uint64_t low7 = word & kLow7;
+    const std::uint64_t atLeastA = low7 + 0x3f3f3f3f3f3f3f3fULL;   // high bit set when byte >= 'A'
+    const std::uint64_t aboveZ = low7 + 0x2525252525252525ULL;     // high bit set when byte > 'Z'
+    const std::uint64_t upper = atLeastA & ~aboveZ & ~word & kHigh;
+    return word | (upper >> 2);
+}
+
+/**
+ * @brief Packs eight bytes into a word, first byte lowest.
+ *
+ * Written bytewise so it stays constexpr; compilers merge it into a single load.
+ */
+constexpr std::uint64_t LoadWord(const char* p) {
+    return static_cast<std::uint64_t>(static_cast<unsigned char>(p[0])) |
+           static_cast<std::uint64_t>(static_cast<unsigned char>(p[1])) << 8 |
+           static_cast<std::uint64_t>(static_cast<unsigned char>(p[2])) << 16 |
+           static_cast<std::uint64_t>(static_cast<unsigned char>(p[3])) << 24 |
+           static_cast<std::uint64_t>(static_cast<unsigned char>(p[4])) << 32 |
+           static_cast<std::uint64_t>(static_cast<unsigned char>(p[5])) << 40 |
+           static_cast<std::uint64_t>(static_cast<unsigned char>(p[6])) << 48 |
+           static_cast<std::uint64_t>(static_cast<unsigned char>(p[7])) << 56;
+}
+
+/**
+ * @brief Packs the last count (< 8) bytes of a string into a word, first byte lowest.
+ */
+constexpr std::uint64_t LoadPartialWord(const char* p, std::size_t count) {
+    std::uint64_t word = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        word |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+    }
+    return word;
+}
+
+/**
+ * @brief Three-way comparison of two strings after ASCII folding.
+ *
+ * @return A negative value, zero or a positive value, like std::string_view::compare.
+ */
+constexpr int CompareIgnoreCase(std::string_view a, std::string_view b) {
+    const std::size_t common = a.size() < b.size() ? a.size() : b.size();
+    std::size_t i = 0;
+
+    // Skip equal eight-byte blocks; the first differing block is resolved bytewise below.
+    for (; i + 8 <= common; i += 8) {
+        if (AsciiToLower8(LoadWord(a.data() + i)) != AsciiToLower8(LoadWord(b.data() + i))) {
+            break;
+        }
+    }
+
+    for (; i < common; ++i) {
+        const unsigned char ca = static_cast<unsigned char>(AsciiToLower(a[i]));
+        const unsigned char cb = static_cast<unsigned char>(AsciiToLower(b[i]));
+        if (ca != cb) {
+            return ca < cb ? -1 : 1;
+        }
+    }
+
+    if (a.size() == b.size()) {
+        return 0;
+    }
+    return a.size() < b.size() ? -1 : 1;
+}
+
+/**
+ * @brief Equality of two strings after ASCII folding.
+ */
+constexpr bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    std::size_t i = 0;
+    for (; i + 8 <= a.size(); i += 8) {
+        if (AsciiToLower8(LoadWord(a.data() + i)) != AsciiToLower8(LoadWord(b.data() + i))) {
+            return false;
+        }
+    }
+    const std::size_t tail = a.size() - i;
+    return tail == 0 ||
+           AsciiToLower8(LoadPartialWord(a.data() + i, tail)) == AsciiToLower8(LoadPartialWord(b.data() + i, tail));
+}
+
+/**
+ * @brief Transparent strict-weak ordering on ASCII-folded strings.
+ *
+ * Usable as the comparator of an ordered container keyed by std::string so
+ * that lookups by std::string_view need neither a temporary nor a folded copy.
+ */
+struct LessIgnoreCase {
+    using is_transparent = void;
+
+    bool operator()(std::string_view a, std::string_view b) const {
+        return CompareIgnoreCase(a, b) < 0;
+    }
+};
+
+} // namespace SmartEnumDetail
+
+#endif // SMARTENUM_DETAIL_ASCIICASE_HPP
@@ -0,0 +1,62 @@
+/**
+ * @file BitOps.hpp
+ * @brief Constexpr bit-counting helpers shared by the bitset-style containers.
+ *
+ * GCC and Clang expose single-instruction builtins that are also usable in
+ * constant expressions; other compilers get portable loops.
+ */
+
+#ifndef SMARTENUM_DETAIL_BITOPS_HPP
+#define SMARTENUM_DETAIL_BITOPS_HPP
+
+#include <cstdint>
+
+namespace SmartEnumDetail {
+
+/**
+ * @brief Number of set bits in @p word.
+ */
+constexpr int PopCount(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for (; word != 0; word &= word - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Index of the lowest set bit of @p word, which must be non-zero.
+ */
+constexpr int CountTrailingZeros(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    for (; (word & 1) == 0; word >>= 1) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief Index of the highest set bit of @p word, which must be non-zero.
+ */
+constexpr int HighestBit(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(word);
+#else
+    int index = 63;
+    for (; (word >> index) == 0; --index) {
+    }
+    return index;
+#endif
+}
+
+} // namespace SmartEnumDetail
+
+#endif // SMARTENUM_DETAIL_BITOPS_HPP
@@ -0,0 +1,82 @@
+/**
+ * @file Config.hpp
+ * @brief Build switches for exception-free and RTTI-free builds.
+ *
+ * SMARTENUM_NO_EXCEPTIONS and SMARTENUM_NO_RTTI may be defined explicitly;
+ * otherwise they are detected from the compiler flags (-fno-exceptions,
+ * -fno-rtti, /EHs-c-, /GR-).
+ *
+ * Without exceptions the throwing API (FromName, FromValue, ...) calls
+ * std::abort() where it would have thrown; use the Find* functions, which
+ * report failure through SmartEnumResult instead. Without RTTI, type names in
+ * messages are taken from the compiler's function signature string.
+ */
+
+#ifndef SMARTENUM_DETAIL_CONFIG_HPP
+#define SMARTENUM_DETAIL_CONFIG_HPP
+
+#include <cstdlib>
+#include <string_view>
+
+#if !defined(SMARTENUM_NO_EXCEPTIONS) && \
+    !(defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
+#define SMARTENUM_NO_EXCEPTIONS
+#endif
+
+#if !defined(SMARTENUM_NO_RTTI) && \
+    !(defined(__cpp_rtti) || defined(__GXX_RTTI) || defined(_CPPRTTI))
+#define SMARTENUM_NO_RTTI
+#endif
+
+#ifndef SMARTENUM_NO_RTTI
+#include <typeinfo>
+#endif
+
+namespace SmartEnumDetail {
+
+/**
+ * @brief Throws TException built from makeMessage(), or aborts when exceptions are disabled.
+ *
+ * The message is produced by a callable so that exception-free builds never
+ * format (or allocate) it.
+ */
+template <typename TException, typename TMessage>
+[[noreturn]] inline void Raise(TMessage&& makeMessage) {
+#ifdef SMARTENUM_NO_EXCEPTIONS
+    (void)makeMessage;
+    std::abort();
+#else
+    throw TException(makeMessage());
+#endif
+}
+
+/**
+ * @brief Name of T for diagnostics: typeid(T).name(), or parsed from the
+ *        function signature when RTTI is disabled.
+ */
+template <typename T>
+inline std::string_view TypeName() {
+#ifndef SMARTENUM_NO_RTTI
+    return typeid(T).name();
+#else
+#if defined(_MSC_VER) && !defined(__clang__)
+    std::string_view signature = __FUNCSIG__;
+    const std::string_view open = "TypeName<";
+    const std::size_t first = signature.find(open);
+    const std::size_t last = signature.rfind(">(void)");
+#else
+    std::string_view signature = __PRETTY_FUNCTION__;
+    const std::string_view open = "T = ";
+    const std::size_t first = signature.find(open);
+    const std::size_t last = signature.find_first_of(";]", first);
+#endif
+    if (first == std::string_view::npos || last == std::string_view::npos) {
+        return signature;
+    }
+    return signature.substr(first + open.size(), last - first - open.size());
+#endif
+}
+
+} // namespace SmartEnumDetail
+
+#endif // SMARTENUM_DETAIL_CONFIG_HPP
@@ -0,0 +1,185 @@
+/**
+ * @file FlagBitRange.hpp
+ * @brief Lazy, non-allocating range over the single-bit flags set in a value.
+ *
+ * Returned by SmartFlagEnum::Decompose(). Iteration clears the lowest set bit
+ * and finds the next one with count-trailing-zeros, mapping each bit to its
+ * flag through a per-bit table, so a full pass costs O(popcount).
+ * WideFlagBitRange does the same for FlagBitset values, skipping zero words.
+ */
+
+#ifndef SMARTENUM_DETAIL_FLAGBITRANGE_HPP
+#define SMARTENUM_DETAIL_FLAGBITRANGE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "BitOps.hpp"
+
+namespace SmartEnumDetail {
+
+/**
+ * @brief Range of the flags whose single bit is set in a value, lowest bit first.
+ *
+ * Bits with no single-bit flag defined for them are not visited; they are
+ * reported by UnmatchedBits().
+ *
+ * @tparam TEnum The flag enum type.
+ * @tparam TValue The underlying integral type.
+ */
+template <typename TEnum, typename TValue>
+class FlagBitRange {
+public:
+    using Bits = std::make_unsigned_t<TValue>;
+
+    /**
+     * @brief Forward iterator yielding `const TEnum&`.
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TEnum;
+        using reference = const TEnum&;
+        using pointer = const TEnum*;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() : bits_(0), byBit_(nullptr) {}
+        Iterator(Bits bits, const TEnum* const* byBit) : bits_(bits), byBit_(byBit) {}
+
+        reference operator*() const { return *byBit_[CountTrailingZeros(bits_)]; }
+        pointer operator->() const { return byBit_[CountTrailingZeros(bits_)]; }
+
+        Iterator& operator++() {
+            bits_ &= static_cast<Bits>(bits_ - 1);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return bits_ == other.bits_; }
+        bool operator!=(const Iterator& other) const { return bits_ != other.bits_; }
+
+    private:
+        Bits bits_;
+        const TEnum* const* byBit_;
+    };
+
+    /**
+     * @param value The value to decompose.
+     * @param byBit Table with one entry per bit: the single-bit flag, or nullptr.
+     * @param covered Mask of the bits that have an entry in @p byBit.
+     */
+    FlagBitRange(TValue value, const TEnum* const* byBit, Bits covered)
+        : matched_(static_cast<Bits>(static_cast<Bits>(value) & covered)),
+          unmatched_(static_cast<Bits>(static_cast<Bits>(value) & ~covered)),
+          byBit_(byBit) {}
+
+    Iterator begin() const { return Iterator(matched_, byBit_); }
+    Iterator end() const { return Iterator(0, byBit_); }
+
+    /**
+     * @brief True if no defined flag bit is set.
+     */
+    bool Empty() const { return matched_ == 0; }
+
+    /**
+     * @brief Number of flags the range visits.
+     */
+    std::size_t Size() const { return static_cast<std::size_t>(PopCount(matched_)); }
+
+    /**
+     * @brief Bits of the value that no single-bit flag covers (0 if fully decomposed).
+     */
+    TValue UnmatchedBits() const { return static_cast<TValue>(unmatched_); }
+
+private:
+    Bits matched_;
+    Bits unmatched_;
+    const TEnum* const* byBit_;
+};
+
+/**
+ * @brief FlagBitRange for FlagBitset values.
+ *
+ * @tparam TEnum The flag enum type.
+ * @tparam TBitset The FlagBitset value type.
+ */
+template <typename TEnum, typename TBitset>
+class WideFlagBitRange {
+public:
+    /**
+     * @brief Forward iterator yielding `const TEnum&`.
+     */
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = TEnum;
+        using reference = const TEnum&;
+        using pointer = const TEnum*;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() : byBit_(nullptr) {}
+        Iterator(typename TBitset::Iterator bit, const TEnum* const* byBit) : bit_(bit), byBit_(byBit) {}
+
+        reference operator*() const { return *byBit_[*bit_]; }
+        pointer operator->() const { return byBit_[*bit_]; }
+
+        Iterator& operator++() {
+            ++bit_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return bit_ == other.bit_; }
+        bool operator!=(const Iterator& other) const { return bit_ != other.bit_; }
+
+    private:
+        typename TBitset::Iterator bit_;
+        const TEnum* const* byBit_;
+    };
+
+    /**
+     * @param value The value to decompose.
+     * @param byBit Table with one entry per bit: the single-bit flag, or nullptr.
+     * @param covered Mask of the bits that have an entry in @p byBit.
+     */
+    WideFlagBitRange(const TBitset& value, const TEnum* const* byBit, const TBitset& covered)
+        : matched_(value & covered), unmatched_(value & ~covered), byBit_(byBit) {}
+
+    Iterator begin() const { return Iterator(matched_.begin(), byBit_); }
+    Iterator end() const { return Iterator(matched_.end(), byBit_); }
+
+    /**
+     * @brief True if no defined flag bit is set.
+     */
+    bool Empty() const { return matched_.None(); }
+
+    /**
+     * @brief Number of flags the range visits.
+     */
+    std::size_t Size() const { return matched_.Count(); }
+
+    /**
+     * @brief Bits of the value that no single-bit flag covers (none if fully decomposed).
+     */
+    const TBitset& UnmatchedBits() const { return unmatched_; }
+
+private:
+    TBitset matched_;
+    TBitset unmatched_;
+    const TEnum* const* byBit_;
+};
+
+} // namespace SmartEnumDetail
+
+#endif // SMARTENUM_DETAIL_FLAGBITRANGE_HPP
@@ -0,0 +1,275 @@
+/**
+ * @file FlagLookupTable.hpp
+ * @brief Flag name and value decoding over a frozen index, and the optional full decode table.
+ *
+ * ParseFlagNames(), DecodeFlagValue() and FormatFlagValue() implement
+ * SmartFlagEnum's lookups against a FrozenIndex. Flag enums with an 8- or 16-bit value type
+ * that derive from UseFlagEnumLookupTable run them once for every bit pattern
+ * when the index is frozen, so that each later lookup is a single indexed load.
+ */
+
+#ifndef SMARTENUM_DETAIL_FLAGLOOKUPTABLE_HPP
+#define SMARTENUM_DETAIL_FLAGLOOKUPTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "BitOps.hpp"
+#include "../SmartEnumResult.hpp"
+
+/**
+ * @brief Marker for SmartFlagEnum types with a uint8_t or uint16_t (or signed) value.
+ *
+ * Decodes every possible value when the enum is frozen: 256 or 65536 entries,
+ * each holding the validity and the decomposition as a bitmask over the
+ * enum's distinct values. FromValue, TryFromValue, FromValueToString and their
+ * Find* forms then read the table instead of decoding. An entry takes 5 bytes,
+ * so the 8-bit table is 1.25 KiB and the 16-bit table 320 KiB. Enums with more
+ * than 32 distinct values get no table and decode on demand.
+ */
+struct UseFlagEnumLookupTable {
+};
+
+namespace SmartEnumDetail {
+
+template <typename TEnum, typename TValue>
+struct FrozenIndex;
+
+/**
+ * @brief True if TEnum opted into the full decode table.
+ */
+template <typename TEnum>
+struct UsesFlagLookupTable : std::is_base_of<UseFlagEnumLookupTable, TEnum> {};
+
+/**
+ * @brief Resolves flag names separated by ',' or '|', calling @p onFlag for each match.
+ *
+ * Tokens are trimmed of spaces and tabs and empty tokens are skipped; parsing
+ * stops at the first unknown name.
+ */
+template <typename TEnum, typename TValue, typename TOnFlag>
+SmartEnumErrc ParseFlagNames(const FrozenIndex<TEnum, TValue>& index, std::string_view names, bool ignoreCase,
+                             TOnFlag&& onFlag) {
+    std::size_t start = 0;
+    while (start <= names.size()) {
+        std::size_t end = names.find_first_of(",|", start);
+        if (end == std::string_view::npos) {
+            end = names.size();
+        }
+
+        // Trim whitespace
+        std::string_view part = names.substr(start, end - start);
+        const std::size_t first = part.find_first_not_of(" \t");
+        if (first != std::string_view::npos) {
+            part = part.substr(first, part.find_last_not_of(" \t") - first + 1);
+
+            const TEnum* foundFlag = ignoreCase ? index.FindNameIgnoreCase(part) : index.FindName(part);
+            if (!foundFlag) {
+                return SmartEnumErrc::NameNotFound;
+            }
+            onFlag(foundFlag);
+        }
+
+        start = end + 1;
+    }
+
+    return SmartEnumErrc::None;
+}
+
+/**
+ * @brief Calls @p onFlag for each flag of @p value: an exact match, else the largest flags first.
+ *
+ * This is the one decomposition behind FromValue() and FromValueToString().
+ * When no multi-bit flag is defined, the largest-first walk is simply the set
+ * bits from the highest down, and it is taken in O(popcount) through
+ * flagByBit. On failure @p onFlag may already have been called.
+ */
+template <typename TEnum, typename TValue, typename TOnFlag>
+SmartEnumErrc WalkFlagValue(const FrozenIndex<TEnum, TValue>& index, const TValue& value, TOnFlag&& onFlag) {
+    // Check if this is an exact match for an existing flag
+    if (const TEnum* exact = index.FindValue(value)) {
+        onFlag(exact);
+        return SmartEnumErrc::None;
+    }
+
+    // Negative values (often used for "All") only resolve through an exact match
+    if (value < 0) {
+        return SmartEnumErrc::NegativeFlagValue;
+    }
+
+    // Reject bits that no flag defines
+    if ((value & ~index.definedBits) != 0) {
+        return SmartEnumErrc::InvalidFlagValue;
+    }
+
+    using Bits = std::make_unsigned_t<TValue>;
+    if (!index.multiBitFlags && (value & ~index.singleBitFlags) == 0) {
+        for (Bits bits = static_cast<Bits>(value); bits != 0;) {
+            const int bit = HighestBit(bits);
+            onFlag(index.flagByBit[static_cast<std::size_t>(bit)]);
+            bits = static_cast<Bits>(bits & ~(Bits(1) << bit));
+        }
+        return SmartEnumErrc::None;
+    }
+
+    // Take the largest flags first: byValue is sorted ascending, so walk it backwards
+    TValue remainingValue = value;
+    for (auto it = index.byValue.rbegin(); it != index.byValue.rend() && remainingValue != 0; ++it) {
+        const TValue flagValue = it->value;
+        if ((remainingValue & flagValue) == flagValue) {
+            onFlag(it->instance);
+            remainingValue &= ~flagValue;
+        }
+    }
+
+    return remainingValue == 0 ? SmartEnumErrc::None : SmartEnumErrc::InvalidFlagValue;
+}
+
+/**
+ * @brief Splits @p value into flag instances, in WalkFlagValue() order.
+ *
+ * With a null @p outResult only the validity is computed, which never allocates.
+ */
+template <typename TEnum, typename TValue>
+SmartEnumErrc DecodeFlagValue(const FrozenIndex<TEnum, TValue>& index, const TValue& value,
+                              std::vector<const TEnum*>* outResult) {
+    if (!outResult) {
+        return WalkFlagValue(index, value, [](const TEnum*) {});
+    }
+    return WalkFlagValue(index, value, [outResult](const TEnum* flag) { outResult->push_back(flag); });
+}
+
+/**
+ * @brief Writes the comma-separated flag names of @p value, in the same order as DecodeFlagValue().
+ *
+ * @p outStr is untouched on error.
+ */
+template <typename TEnum, typename TValue>
+SmartEnumErrc FormatFlagValue(const FrozenIndex<TEnum, TValue>& index, const TValue& value, std::string& outStr) {
+    // Validate first so that nothing is written for an invalid value
+    const SmartEnumErrc error = DecodeFlagValue<TEnum, TValue>(index, value, nullptr);
+    if (error != SmartEnumErrc::None) {
+        return error;
+    }
+
+    outStr.clear();
+    WalkFlagValue(index, value, [&outStr](const TEnum* flag) {
+        if (!outStr.empty()) {
+            outStr += ", ";
+        }
+        outStr += flag->Name();
+    });
+    return SmartEnumErrc::None;
+}
+
+/**
+ * @brief Decode results for every bit pattern of a narrow flag value type.
+ *
+ * Entry i describes the value whose bits are i: its error code, and the flags
+ * of its decomposition as bits over the index's byValue positions. Decoding
+ * takes the set bits from the highest down, which is the largest-first order
+ * of WalkFlagValue(); formatting appends the same flags' names.
+ */
+template <typename TEnum, typename TValue>
+class FlagLookupTable {
+public:
+    using Mask = std::uint32_t;
+
+    // Distinct flag values a table can refer to; more and Build() leaves the table empty.
+    static constexpr std::size_t kMaxFlags = std::numeric_limits<Mask>::digits;
+
+    static_assert(sizeof(Mask) + sizeof(std::uint8_t) == 5, "5 bytes per table entry");
+
+    /**
+     * @brief Decodes every value against @p index, unless it has more than kMaxFlags values.
+     */
+    void Build(const FrozenIndex<TEnum, TValue>& index) {
+        using Bits = std::make_unsigned_t<TValue>;
+        const std::size_t count = std::size_t(std::numeric_limits<Bits>::max()) + 1;
+        flags_.clear();
+        masks_.clear();
+        errors_.clear();
+        if (index.byValue.size() > kMaxFlags) {
+            return;
+        }
+
+        for (const auto& entry : index.byValue) {
+            flags_.push_back(entry.instance);
+        }
+        masks_.assign(count, 0);
+        errors_.assign(count, static_cast<std::uint8_t>(SmartEnumErrc::None));
+        for (std::size_t bits = 0; bits < count; ++bits) {
+            const TValue value = static_cast<TValue>(static_cast<Bits>(bits));
+            Mask mask = 0;
+            const SmartEnumErrc error = WalkFlagValue(index, value, [this, &mask](const TEnum* flag) {
+                mask |= Mask(1) << positionOf(flag);
+            });
+            errors_[bits] = static_cast<std::uint8_t>(error);
+            masks_[bits] = error == SmartEnumErrc::None ? mask : 0;
+        }
+        flags_.shrink_to_fit();
+    }
+
+    /**
+     * @brief True if Build() declined to build the table.
+     */
+    bool Empty() const { return masks_.empty(); }
+
+    /**
+     * @brief Same contract as DecodeFlagValue().
+     */
+    SmartEnumErrc Decode(const TValue& value, std::vector<const TEnum*>* outResult) const {
+        const std::size_t i = static_cast<std::make_unsigned_t<TValue>>(value);
+        const SmartEnumErrc error = static_cast<SmartEnumErrc>(errors_[i]);
+        if (error == SmartEnumErrc::None && outResult) {
+            for (Mask mask = masks_[i]; mask != 0;) {
+                const int position = HighestBit(mask);
+                outResult->push_back(flags_[static_cast<std::size_t>(position)]);
+                mask &= ~(Mask(1) << position);
+            }
+        }
+        return error;
+    }
+
+    /**
+     * @brief Same contract as FormatFlagValue().
+     */
+    SmartEnumErrc Format(const TValue& value, std::string& outStr) const {
+        const std::size_t i = static_cast<std::make_unsigned_t<TValue>>(value);
+        const SmartEnumErrc error = static_cast<SmartEnumErrc>(errors_[i]);
+        if (error == SmartEnumErrc::None) {
+            outStr.clear();
+            for (Mask mask = masks_[i]; mask != 0;) {
+                const int position = HighestBit(mask);
+                if (!outStr.empty()) {
+                    outStr += ", ";
+                }
+                outStr += flags_[static_cast<std::size_t>(position)]->Name();
+                mask &= ~(Mask(1) << position);
+            }
+        }
+        return error;
+    }
+
+private:
+    std::size_t positionOf(const TEnum* flag) const {
+        std::size_t position = 0;
+        while (flags_[position] != flag) {
+            ++position;
+        }
+        return position;
+    }
+
+    std::vector<const TEnum*> flags_;    // the index's byValue instances, ascending by value
+    std::vector<Mask> masks_;            // per bit pattern: positions in flags_ of its decomposition
+    std::vector<std::uint8_t> errors_;   // per bit pattern: its SmartEnumErrc
+};
+
+} // namespace SmartEnumDetail
+
+#endif // SMARTENUM_DETAIL_FLAGLOOKUPTABLE_HPP
@@ -0,0 +1,503 @@
+/**
+ * @file Registry.hpp
+ * @brief Instance registry and frozen lookup indexes shared by SmartEnum and SmartFlagEnum.
+ *
+ * Instances register themselves during static initialization. The first
+ * lookup (or an explicit Freeze()) compacts everything registered so far into
+ * contiguous sorted arrays and releases the node-based staging set, so
+ * steady-state lookups are binary searches over flat memory, or a table probe
+ * for integral values. See Registry for
+ * the concurrency contract and what late registrations cost.
+ */
+
+#ifndef SMARTENUM_DETAIL_REGISTRY_HPP
+#define SMARTENUM_DETAIL_REGISTRY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "AsciiCase.hpp"
+#include "BitOps.hpp"
+#include "FlagLookupTable.hpp"
+#include "../FlagBitset.hpp"
+#include "../PerfectNameHash.hpp"
+
+namespace SmartEnumDetail {
+
+/**
+ * @brief Immutable lookup tables built from a snapshot of the registered instances.
+ *
+ * The instance list, the value array and the per-bit flag data are rebuilt
+ * for every snapshot. The name tables, the dense value table, the perfect-hash
+ * map and the flag decode table live in Tables, which a snapshot may share
+ * with the one before it: after a late registration they are rebuilt only
+ * once the instances they do not cover (the tail) outnumber half of those they
+ * do, and until then lookups that miss them scan the tail.
+ *
+ * @tparam TEnum The enum type.
+ * @tparam TValue The underlying value type.
+ */
+template <typename TEnum, typename TValue>
+struct FrozenIndex {
+    struct NameEntry {
+        std::string_view name;
+        const TEnum* instance;
+    };
+
+    struct ValueEntry {
+        TValue value;
+        const TEnum* instance;
+    };
+
+    // Value ranges spanning more than this many slots per instance are not given a dense table.
+    static constexpr std::size_t kMaxDenseSlotsPerInstance = 4;
+
+    static constexpr bool hasDenseValues() {
+        return std::is_integral<TValue>::value && !std::is_same<TValue, bool>::value;
+    }
+
+    /**
+     * @brief The tables over instances[0, indexed), shared by snapshots until the tail outgrows them.
+     */
+    struct Tables {
+        std::size_t indexed = 0;
+        std::vector<NameEntry> byName;             // sorted by name
+        std::vector<NameEntry> byNameIgnoreCase;   // sorted by ASCII-folded name, first registration wins
+
+        // Slot i holds the instance whose value is minValue + i (or nullptr for a hole).
+        // Empty when the value type is not integral or the range is too sparse.
+        std::vector<const TEnum*> denseValues;
+        TValue minValue{};
+
+        // Open-addressed hash of byValue, at most half full, for integral ranges too sparse for
+        // denseValues; a null instance ends a probe. Slot of a value: valueSlot(value, valueShift).
+        std::vector<ValueEntry> sparseValues;
+        unsigned valueShift = 0;
+
+        // Instances by position in TEnum::NameHash (see PerfectNameHash.hpp). Empty unless the
+        // enum declares a name hash that covers every indexed name.
+        std::vector<const TEnum*> hashedByName;
+        std::vector<const TEnum*> hashedByNameIgnoreCase;
+
+        // Decode of every possible value; only built for flag enums deriving from UseFlagEnumLookupTable.
+        FlagLookupTable<TEnum, TValue> flagTable;
+    };
+
+    std::vector<const TEnum*> instances;       // registration order
+    std::vector<ValueEntry> byValue;           // sorted by value, first registration wins
+
+    // OR of every registered value; lets flag decoding reject undefined bits in one test.
+    // Walking byValue back to front gives the largest-first flag decode order.
+    TValue definedBits{};
+
+    // Entry b is the instance whose value is exactly bit b (first registration wins), or
+    // nullptr; singleBitFlags masks the bits that have one. Empty unless values are integral
+    // or FlagBitsets.
+    std::vector<const TEnum*> flagByBit;
+    TValue singleBitFlags{};
+
+    // True if some positive flag has more than one bit; the largest-first decode then
+    // has to consult byValue instead of just walking bits from the top.
+    bool multiBitFlags = false;
+
+    std::shared_ptr<const Tables> tables = std::make_shared<Tables>();
+
+    /**
+     * @brief Rebuilds every index from the given instances, in registration order.
+     *
+     * @param previous The snapshot being replaced, whose tables are reused if
+     *        the instances they do not cover are few enough; nullptr to rebuild them.
+     */
+    void Build(std::vector<const TEnum*> registered, const FrozenIndex* previous = nullptr) {
+        instances = std::move(registered);
+        instances.shrink_to_fit();
+
+        byValue.clear();
+        byValue.reserve(instances.size());
+        for (const TEnum* instance : instances) {
+            byValue.push_back(ValueEntry{instance->Value(), instance});
+        }
+        std::stable_sort(byValue.begin(), byValue.end(),
+                         [](const ValueEntry& a, const ValueEntry& b) { return a.value < b.value; });
+        byValue.erase(
+            std::unique(byValue.begin(), byValue.end(),
+                        [](const ValueEntry& a, const ValueEntry& b) { return !(a.value < b.value) && !(b.value < a.value); }),
+            byValue.end());
+        byValue.shrink_to_fit();
+
+        buildFlagBits();
+
+        if (previous && instances.size() - previous->tables->indexed <= previous->tables->indexed / 2) {
+            tables = previous->tables;
+            return;
+        }
+
+        std::shared_ptr<Tables> built = std::make_shared<Tables>();
+        built->indexed = instances.size();
+        buildNames(*built);
+        buildDenseValues(*built);
+        tables = built;
+        // Both need the lookups above to see every instance
+        buildNameHash(*built);
+        buildFlagTable(*built);
+    }
+
+    /**
+     * @brief The full flag decode table, or nullptr if it is not built, too large or misses late instances.
+     */
+    const FlagLookupTable<TEnum, TValue>* FlagTable() const {
+        if constexpr (UsesFlagLookupTable<TEnum>::value) {
+            if (tables->indexed == instances.size() && !tables->flagTable.Empty()) {
+                return &tables->flagTable;
+            }
+        }
+        return nullptr;
+    }
+
+    const TEnum* FindName(std::string_view name) const {
+        if (const TEnum* found = findIndexedName(name)) {
+            return found;
+        }
+        for (std::size_t i = tables->indexed; i < instances.size(); ++i) {
+            if (instances[i]->Name() == name) {
+                return instances[i];
+            }
+        }
+        return nullptr;
+    }
+
+    const TEnum* FindNameIgnoreCase(std::string_view name) const {
+        if (const TEnum* found = findIndexedNameIgnoreCase(name)) {
+            return found;
+        }
+        for (std::size_t i = tables->indexed; i < instances.size(); ++i) {
+            if (EqualsIgnoreCase(instances[i]->Name(), name)) {
+                return instances[i];
+            }
+        }
+        return nullptr;
+    }
+
+    const TEnum* FindValue(const TValue& value) const {
+        if constexpr (hasDenseValues()) {
+            const std::vector<const TEnum*>& denseValues = tables->denseValues;
+            if (!denseValues.empty() && tables->indexed == instances.size()) {
+                using UnsignedValue = std::make_unsigned_t<TValue>;
+                // A single unsigned compare rejects values on both sides of the range.
+                const UnsignedValue offset = static_cast<UnsignedValue>(
+                    static_cast<UnsignedValue>(value) - static_cast<UnsignedValue>(tables->minValue));
+                return offset < denseValues.size() ? denseValues[offset] : nullptr;
+            }
+
+            const std::vector<ValueEntry>& sparseValues = tables->sparseValues;
+            if (!sparseValues.empty() && tables->indexed == instances.size()) {
+                const std::size_t mask = sparseValues.size() - 1;
+                for (std::size_t slot = valueSlot(value, tables->valueShift);; slot = (slot + 1) & mask) {
+                    const ValueEntry& entry = sparseValues[slot];
+                    if (!entry.instance || entry.value == value) {
+                        return entry.instance;
+                    }
+                }
+            }
+        }
+
+        auto it = std::lower_bound(byValue.begin(), byValue.end(), value,
+                                   [](const ValueEntry& entry, const TValue& key) { return entry.value < key; });
+        return it != byValue.end() && !(value < it->value) ? it->instance : nullptr;
+    }
+
+private:
+    const TEnum* findIndexedName(std::string_view name) const {
+        if constexpr (HasPerfectNameHash<TEnum>::value) {
+            if (!tables->hashedByName.empty()) {
+                const std::size_t position = TEnum::NameHash.Find(name);
+                return position < tables->hashedByName.size() ? tables->hashedByName[position] : nullptr;
+            }
+        }
+
+        const std::vector<NameEntry>& byName = tables->byName;
+        auto it = std::lower_bound(byName.begin(), byName.end(), name,
+                                   [](const NameEntry& entry, std::string_view key) { return entry.name < key; });
+        return it != byName.end() && it->name == name ? it->instance : nullptr;
+    }
+
+    const TEnum* findIndexedNameIgnoreCase(std::string_view name) const {
+        if constexpr (HasPerfectNameHash<TEnum>::value) {
+            if (!tables->hashedByNameIgnoreCase.empty()) {
+                const std::size_t position = TEnum::NameHash.FindIgnoreCase(name);
+                return position < tables->hashedByNameIgnoreCase.size() ? tables->hashedByNameIgnoreCase[position]
+                                                                       : nullptr;
+            }
+        }
+
+        const std::vector<NameEntry>& byNameIgnoreCase = tables->byNameIgnoreCase;
+        auto it = std::lower_bound(byNameIgnoreCase.begin(), byNameIgnoreCase.end(), name,
+                                   [](const NameEntry& entry, std::string_view key) {
+                                       return CompareIgnoreCase(entry.name, key) < 0;
+                                   });
+        return it != byNameIgnoreCase.end() && EqualsIgnoreCase(it->name, name) ? it->instance : nullptr;
+    }
+
+    void buildNames(Tables& built) const {
+        std::vector<NameEntry>& byName = built.byName;
+        byName.reserve(instances.size());
+        for (const TEnum* instance : instances) {
+            byName.push_back(NameEntry{instance->Name(), instance});
+        }
+        std::vector<NameEntry>& byNameIgnoreCase = built.byNameIgnoreCase;
+        byNameIgnoreCase = byName;
+        std::sort(byName.begin(), byName.end(),
+                  [](const NameEntry& a, const NameEntry& b) { return a.name < b.name; });
+
+        // Stable sorts keep registration order among equal keys, so unique() keeps the first.
+        std::stable_sort(byNameIgnoreCase.begin(), byNameIgnoreCase.end(),
+                         [](const NameEntry& a, const NameEntry& b) { return CompareIgnoreCase(a.name, b.name) < 0; });
+        byNameIgnoreCase.erase(
+            std::unique(byNameIgnoreCase.begin(), byNameIgnoreCase.end(),
+                        [](const NameEntry& a, const NameEntry& b) { return EqualsIgnoreCase(a.name, b.name); }),
+            byNameIgnoreCase.end());
+        byNameIgnoreCase.shrink_to_fit();
+    }
+
+    void buildNameHash(Tables& built) const {
+        if constexpr (HasPerfectNameHash<TEnum>::value) {
+            const auto& hash = TEnum::NameHash;
+            std::vector<const TEnum*> exact(hash.Size());
+            std::vector<const TEnum*> folded(hash.Size());
+            std::size_t covered = 0;
+            for (std::size_t i = 0; i < hash.Size(); ++i) {
+                exact[i] = FindName(hash.Name(i));
+                covered += exact[i] ? 1 : 0;
+                // Resolved through the sorted index so the first registered instance still wins.
+                folded[i] = FindNameIgnoreCase(hash.Name(i));
+            }
+
+            // A registered name missing from the hash would become unreachable; keep binary search then.
+            if (covered != built.byName.size()) {
+                return;
+            }
+            built.hashedByName = std::move(exact);
+            built.hashedByNameIgnoreCase = std::move(folded);
+        } else {
+            (void)built;
+        }
+    }
+
+    void buildFlagBits() {
+        definedBits = TValue{};
+        singleBitFlags = TValue{};
+        multiBitFlags = false;
+        flagByBit.clear();
+        if constexpr (hasDenseValues()) {
+            using UnsignedValue = std::make_unsigned_t<TValue>;
+            constexpr int kBits = std::numeric_limits<UnsignedValue>::digits;
+            flagByBit.assign(kBits, nullptr);
+            for (const ValueEntry& entry : byValue) {
+                definedBits = static_cast<TValue>(definedBits | entry.value);
+                const UnsignedValue bits = static_cast<UnsignedValue>(entry.value);
+                if (bits != 0 && (bits & (bits - 1)) == 0) {
+                    flagByBit[CountTrailingZeros(bits)] = entry.instance;
+                    singleBitFlags = static_cast<TValue>(singleBitFlags | entry.value);
+                } else if (entry.value > 0) {
+                    multiBitFlags = true;
+                }
+            }
+        } else if constexpr (IsFlagBitset<TValue>::value) {
+            flagByBit.assign(TValue::Size(), nullptr);
+            for (const ValueEntry& entry : byValue) {
+                definedBits |= entry.value;
+                if (entry.value.Count() == 1) {
+                    flagByBit[*entry.value.begin()] = entry.instance;
+                    singleBitFlags |= entry.value;
+                } else if (entry.value.Any()) {
+                    multiBitFlags = true;
+                }
+            }
+        }
+    }
+
+    void buildFlagTable(Tables& built) const {
+        if constexpr (UsesFlagLookupTable<TEnum>::value) {
+            static_assert(hasDenseValues() && sizeof(TValue) <= 2,
+                          "UseFlagEnumLookupTable needs an 8- or 16-bit integral value type");
+            built.flagTable.Build(*this);
+        } else {
+            (void)built;
+        }
+    }
+
+    void buildDenseValues(Tables& built) const {
+        if constexpr (hasDenseValues()) {
+            using UnsignedValue = std::make_unsigned_t<TValue>;
+            if (byValue.empty()) {
+                return;
+            }
+
+            // byValue is sorted, so the range is [front, back].
+            const TValue first = byValue.front().value;
+            const std::uintmax_t span = static_cast<UnsignedValue>(
+                static_cast<UnsignedValue>(byValue.back().value) - static_cast<UnsignedValue>(first));
+            if (span >= byValue.size() * kMaxDenseSlotsPerInstance) {
+                buildSparseValues(built);
+                return;
+            }
+
+            built.minValue = first;
+            built.denseValues.assign(static_cast<std::size_t>(span) + 1, nullptr);
+            for (const ValueEntry& entry : byValue) {
+                built.denseValues[static_cast<UnsignedValue>(
+                    static_cast<UnsignedValue>(entry.value) - static_cast<UnsignedValue>(first))] = entry.instance;
+            }
+        } else {
+            (void)built;
+        }
+    }
+
+    void buildSparseValues(Tables& built) const {
+        unsigned bits = 1;
+        while ((std::size_t(1) << bits) < byValue.size() * 2) {
+            ++bits;
+        }
+        built.valueShift = 64 - bits;
+        built.sparseValues.assign(std::size_t(1) << bits, ValueEntry{TValue{}, nullptr});
+        const std::size_t mask = built.sparseValues.size() - 1;
+        for (const ValueEntry& entry : byValue) {
+            std::size_t slot = valueSlot(entry.value, built.valueShift);
+            while (built.sparseValues[slot].instance) {
+                slot = (slot + 1) & mask;
+            }
+            built.sparseValues[slot] = entry;
+        }
+    }
+
+    /**
+     * @brief Fibonacci hash of @p value: its top 64 - @p shift bits after one multiply.
+     */
+    static std::size_t valueSlot(const TValue& value, unsigned shift) {
+        using UnsignedValue = std::make_unsigned_t<TValue>;
+        const std::uint64_t bits = static_cast<std::uint64_t>(static_cast<UnsignedValue>(value));
+        return static_cast<std::size_t>((bits * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+};
+
+/**
+ * @brief Collects instances as they register and hands out the frozen index.
+ *
+ * Concurrency contract:
+ * - Register() and Freeze() are serialized by a mutex, so instances may be
+ *   defined from several threads, e.g. by lazily loaded shared objects.
+ * - Each freeze builds a new FrozenIndex and publishes it with a release
+ *   store. Lookup() reads a published index with two acquire loads, and no
+ *   lock or read-modify-write, unless registrations are pending.
+ * - Published indexes are never modified or freed before the registry, so
+ *   references returned by earlier lookups (List(), Decompose()) stay valid
+ *   after late registrations, and so does an index a reader is still using.
+ * - To bound what that retains, a late freeze rebuilds only the instance
+ *   list, the value array and the per-bit flag data (about 24 bytes per
+ *   instance plus one pointer per bit). The name, value, perfect-hash
+ *   and flag decode tables are shared with the previous index until the late
+ *   instances outnumber half of those they cover, so every such table ever
+ *   built totals at most three times the size of the final one.
+ */
+template <typename TEnum, typename TValue>
+class Registry {
+public:
+    using Index = FrozenIndex<TEnum, TValue>;
+
+    Registry() : published_(nullptr), dirty_(false) {
+        snapshots_.emplace_back(new Index());
+        published_.store(snapshots_.back().get(), std::memory_order_release);
+    }
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    /**
+     * @brief Stages an instance for the next freeze.
+     *
+     * @param outOrdinal Receives the instance's ordinal on success.
+     * @return false if an instance with the same name is already registered.
+     */
+    bool Register(const TEnum* instance, std::size_t& outOrdinal) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Index& index = *published_.load(std::memory_order_relaxed);
+        std::string_view name = instance->Name();
+        if (index.FindName(name) || !pendingNames_.insert(name).second) {
+            return false;
+        }
+        outOrdinal = index.instances.size() + pending_.size();
+        pending_.push_back(instance);
+        dirty_.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of registered instances, frozen or not.
+     */
+    std::size_t Size() {
+        if (!dirty_.load(std::memory_order_acquire)) {
+            return published_.load(std::memory_order_acquire)->instances.size();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        return published_.load(std::memory_order_relaxed)->instances.size() + pending_.size();
+    }
+
+    /**
+     * @brief Returns the lookup index, freezing pending registrations first.
+     */
+    const Index& Lookup() {
+        if (dirty_.load(std::memory_order_acquire)) {
+            Freeze();
+        }
+        return *published_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Compacts all registered instances into a newly published index.
+     */
+    void Freeze() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.empty()) {
+            return;
+        }
+
+        const Index& current = *published_.load(std::memory_order_relaxed);
+        std::vector<const TEnum*> all;
+        all.reserve(current.instances.size() + pending_.size());
+        all.insert(all.end(), current.instances.begin(), current.instances.end());
+        all.insert(all.end(), pending_.begin(), pending_.end());
+
+        std::unique_ptr<Index> next(new Index());
+        next->Build(std::move(all), &current);
+        snapshots_.push_back(std::move(next));
+        published_.store(snapshots_.back().get(), std::memory_order_release);
+
+        // Release the staging storage; swapping with empties frees the node and array blocks.
+        std::vector<const TEnum*>().swap(pending_);
+        std::set<std::string_view>().swap(pendingNames_);
+        dirty_.store(false, std::memory_order_release);
+    }
+
+private:
+    std::atomic<const Index*> published_;
+    std::atomic<bool> dirty_;  // true while pending_ is non-empty
+
+    std::mutex mutex_;  // guards everything below
+    std::vector<std::unique_ptr<Index>> snapshots_;
+    std::vector<const TEnum*> pending_;
+    std::set<std::string_view> pendingNames_;
+};
+
+} // namespace SmartEnumDetail
+
+#endif // SMARTENUM_DETAIL_REGISTRY_HPP
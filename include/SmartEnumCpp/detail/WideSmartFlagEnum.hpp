@@ -0,0 +1,446 @@
+/**
+ * @file WideSmartFlagEnum.hpp
+ * @brief SmartFlagEnum specialization for FlagBitset values (more than 64 flags).
+ *
+ * Included by SmartFlagEnum.hpp. The specialization keeps the name and value
+ * API of SmartFlagEnum, including the pointer and length name overloads;
+ * values are FlagBitset<Bits> instead of an integer, so there is no
+ * negative-value handling and no lookup table policy, and Flag<B>() takes a
+ * bit position rather than a value.
+ */
+
+#ifndef SMARTENUM_DETAIL_WIDESMARTFLAGENUM_HPP
+#define SMARTENUM_DETAIL_WIDESMARTFLAGENUM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../FlagBitset.hpp"
+#include "../SmartEnumResult.hpp"
+#include "FlagBitRange.hpp"
+#include "FlagLookupTable.hpp"
+#include "Registry.hpp"
+
+/**
+ * @brief SmartFlagEnum whose flags are bit positions of a FlagBitset.
+ *
+ * Example:
+ * @code
+ * class Capability : public SmartFlagEnum<Capability, FlagBitset<160>> {
+ * public:
+ *     static const Capability &Avx512;
+ *     Capability(const std::string &name, ValueType value) : SmartFlagEnum(name, value) {}
+ * };
+ * const Capability &Capability::Avx512 = *new Capability("Avx512", Capability::Flag<131>());
+ * @endcode
+ *
+ * @tparam TEnum The derived flag enum type.
+ * @tparam Bits Number of bit positions.
+ */
+template <typename TEnum, std::size_t Bits>
+class SmartFlagEnum<TEnum, FlagBitset<Bits>>
+{
+public:
+    using ValueType = FlagBitset<Bits>;
+    using EnumType = TEnum;
+    using DecomposeRange = SmartEnumDetail::WideFlagBitRange<TEnum, ValueType>;
+
+    SmartFlagEnum(const SmartFlagEnum &) = delete;
+    SmartFlagEnum &operator=(const SmartFlagEnum &) = delete;
+
+    /**
+     * @brief Gets the flag instance's name.
+     */
+    inline const std::string &Name() const { return name_; }
+
+    /**
+     * @brief Gets the flag instance's bits.
+     */
+    inline const ValueType &Value() const { return value_; }
+
+    /**
+     * @brief Gets the zero-based registration position of the flag instance.
+     */
+    inline std::size_t Ordinal() const { return ordinal_; }
+
+    inline std::string ToString() const { return name_; }
+    inline bool Equals(const TEnum &other) const { return value_ == other.Value(); }
+    inline bool operator==(const SmartFlagEnum &other) const { return value_ == other.value_; }
+    inline bool operator!=(const SmartFlagEnum &other) const { return !(*this == other); }
+
+    /**
+     * @brief Implicit conversion to the value type.
+     */
+    inline operator const ValueType &() const { return value_; }
+
+    /**
+     * @brief Returns the value with only bit @p B set, checked against Bits at compile time.
+     *
+     * @code
+     * const Capability Capability::Avx512("Avx512", Flag<131>());
+     * @endcode
+     */
+    template <std::size_t B>
+    static constexpr ValueType Flag()
+    {
+        static_assert(B < Bits, "flag bit position must be below the FlagBitset size");
+        return ValueType::Bit(B);
+    }
+
+    /**
+     * @brief Returns a list of all flag instances.
+     */
+    static const std::vector<const TEnum *> &List() { return registry().Lookup().instances; }
+
+    /**
+     * @brief Compacts the lookup indexes into flat sorted arrays.
+     */
+    static void Freeze() { registry().Freeze(); }
+
+    /**
+     * @brief Returns the number of defined flag instances.
+     */
+    static std::size_t Count() { return registry().Size(); }
+
+    /**
+     * @brief Returns flag instances by a list of names separated by ',' or '|'.
+     * @throws InvalidFlagEnumValueParseException if any name is not found.
+     */
+    static std::vector<const TEnum *> FromName(std::string_view names, bool ignoreCase = false)
+    {
+        std::vector<const TEnum *> result;
+        if (!TryFromName(names, result, ignoreCase))
+        {
+            SmartEnumDetail::Raise<InvalidFlagEnumValueParseException>([&]
+            {
+                return "Failed to parse one or more flags in \"" + std::string(names) + "\" for type " +
+                       std::string(SmartEnumDetail::TypeName<TEnum>());
+            });
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns flag instances by names given as pointer and length.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static std::vector<const TEnum *> FromName(const char *names, TSize length, bool ignoreCase = false)
+    {
+        return FromName(std::string_view(names, static_cast<std::size_t>(length)), ignoreCase);
+    }
+
+    /**
+     * @brief Tries to parse flag names separated by ',' or '|'.
+     */
+    static bool TryFromName(std::string_view names, std::vector<const TEnum *> &outResult, bool ignoreCase = false)
+    {
+        outResult.clear();
+        return parseNames(names, ignoreCase, [&outResult](const TEnum *flag) { outResult.push_back(flag); }) ==
+               SmartEnumErrc::None;
+    }
+
+    /**
+     * @brief Tries to parse flag names separated by ',' or '|' into combined bits.
+     *
+     * @p outValue is only written on success; nothing is allocated.
+     */
+    static bool TryFromName(std::string_view names, ValueType &outValue, bool ignoreCase = false)
+    {
+        ValueType mask;
+        if (parseNames(names, ignoreCase, [&mask](const TEnum *flag) { mask |= flag->Value(); }) !=
+            SmartEnumErrc::None)
+        {
+            return false;
+        }
+        outValue = mask;
+        return true;
+    }
+
+    /**
+     * @brief Tries to parse flag names given as pointer and length.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static bool TryFromName(const char *names, TSize length, std::vector<const TEnum *> &outResult,
+                            bool ignoreCase = false)
+    {
+        return TryFromName(std::string_view(names, static_cast<std::size_t>(length)), outResult, ignoreCase);
+    }
+
+    /**
+     * @brief Parses flag names separated by ',' or '|' without throwing.
+     */
+    static SmartEnumResult<std::vector<const TEnum *>> FindName(std::string_view names, bool ignoreCase = false)
+    {
+        const SmartEnumErrc error = parseNames(names, ignoreCase, [](const TEnum *) {});
+        if (error != SmartEnumErrc::None)
+        {
+            return error;
+        }
+        std::vector<const TEnum *> result;
+        parseNames(names, ignoreCase, [&result](const TEnum *flag) { result.push_back(flag); });
+        return result;
+    }
+
+    /**
+     * @brief Parses flag names given as pointer and length, without throwing.
+     */
+    template <typename TSize,
+              typename = std::enable_if_t<std::is_integral<TSize>::value && !std::is_same<TSize, bool>::value>>
+    static SmartEnumResult<std::vector<const TEnum *>> FindName(const char *names, TSize length,
+                                                                bool ignoreCase = false)
+    {
+        return FindName(std::string_view(names, static_cast<std::size_t>(length)), ignoreCase);
+    }
+
+    /**
+     * @brief Returns the flag instances of combined bits: an exact match, else the largest flags first.
+     * @throws InvalidFlagEnumValueParseException if a set bit is not covered by the defined flags.
+     */
+    static std::vector<const TEnum *> FromValue(const ValueType &value)
+    {
+        std::vector<const TEnum *> result;
+        if (!TryFromValue(value, result))
+        {
+            SmartEnumDetail::Raise<InvalidFlagEnumValueParseException>([&]
+            {
+                return "Value " + value.ToString() + " could not be converted to a valid flag for " +
+                       std::string(SmartEnumDetail::TypeName<TEnum>());
+            });
+        }
+        return result;
+    }
+
+    /**
+     * @brief Tries to interpret combined bits.
+     */
+    static bool TryFromValue(const ValueType &value, std::vector<const TEnum *> &outResult)
+    {
+        outResult.clear();
+        if (decodeValue(value, &outResult) != SmartEnumErrc::None)
+        {
+            outResult.clear();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Interprets combined bits without throwing.
+     */
+    static SmartEnumResult<std::vector<const TEnum *>> FindValue(const ValueType &value)
+    {
+        const SmartEnumErrc error = decodeValue(value, nullptr);
+        if (error != SmartEnumErrc::None)
+        {
+            return error;
+        }
+        std::vector<const TEnum *> result;
+        decodeValue(value, &result);
+        return result;
+    }
+
+    /**
+     * @brief Iterates the single-bit flags set in a value, lowest bit first, skipping zero words.
+     */
+    static DecomposeRange Decompose(const ValueType &value)
+    {
+        const auto &index = registry().Lookup();
+        return DecomposeRange(value, index.flagByBit.data(), index.singleBitFlags);
+    }
+
+    /**
+     * @brief Converts combined bits into a comma-separated string of flag names.
+     * @throws InvalidFlagEnumValueParseException if the bits are not a valid combination.
+     */
+    static std::string FromValueToString(const ValueType &value)
+    {
+        std::string result;
+        if (!TryFromValueToString(value, result))
+        {
+            SmartEnumDetail::Raise<InvalidFlagEnumValueParseException>([&]
+            {
+                return "Value " + value.ToString() + " could not be converted to a valid flag string for " +
+                       std::string(SmartEnumDetail::TypeName<TEnum>());
+            });
+        }
+        return result;
+    }
+
+    /**
+     * @brief Tries to convert combined bits into their string representation.
+     */
+    static bool TryFromValueToString(const ValueType &value, std::string &outStr)
+    {
+        return formatValue(value, outStr) == SmartEnumErrc::None;
+    }
+
+    /**
+     * @brief Converts combined bits into a comma-separated string without throwing.
+     */
+    static SmartEnumResult<std::string> FindValueToString(const ValueType &value)
+    {
+        std::string result;
+        const SmartEnumErrc error = formatValue(value, result);
+        if (error != SmartEnumErrc::None)
+        {
+            return error;
+        }
+        return result;
+    }
+
+protected:
+    /**
+     * @brief Protected constructor. Registers the flag instance.
+     */
+    SmartFlagEnum(const std::string &name, const ValueType &value) : name_(name), value_(value), ordinal_(0)
+    {
+        if (name.empty())
+        {
+            SmartEnumDetail::Raise<std::invalid_argument>([] { return "SmartFlagEnum name cannot be empty"; });
+        }
+        if (!registry().Register(static_cast<const TEnum *>(this), ordinal_))
+        {
+            SmartEnumDetail::Raise<std::runtime_error>([&name]
+            {
+                return "Duplicate SmartFlagEnum name \"" + name + "\"";
+            });
+        }
+    }
+    ~SmartFlagEnum() = default;
+
+private:
+    std::string name_;
+    ValueType value_;
+    std::size_t ordinal_;
+
+    using Registry = SmartEnumDetail::Registry<TEnum, ValueType>;
+
+    static Registry &registry()
+    {
+        static Registry r;
+        return r;
+    }
+
+    template <typename TOnFlag>
+    static SmartEnumErrc parseNames(std::string_view names, bool ignoreCase, TOnFlag &&onFlag)
+    {
+        return SmartEnumDetail::ParseFlagNames(registry().Lookup(), names, ignoreCase, std::forward<TOnFlag>(onFlag));
+    }
+
+    /**
+     * @brief Calls @p onFlag for each flag of @p value: an exact match, else the largest flags first.
+     */
+    template <typename TOnFlag>
+    static SmartEnumErrc walkValue(const ValueType &value, TOnFlag &&onFlag)
+    {
+        const auto &index = registry().Lookup();
+        if (const TEnum *exact = index.FindValue(value))
+        {
+            onFlag(exact);
+            return SmartEnumErrc::None;
+        }
+
+        if ((value & ~index.definedBits).Any())
+        {
+            return SmartEnumErrc::InvalidFlagValue;
+        }
+
+        // Only single-bit flags: take the set bits from the top word down, skipping zero words
+        if (!index.multiBitFlags)
+        {
+            for (std::size_t word = ValueType::kWordCount; word-- > 0;)
+            {
+                for (std::uint64_t bits = value.Word(word); bits != 0;)
+                {
+                    const int bit = SmartEnumDetail::HighestBit(bits);
+                    onFlag(index.flagByBit[word * 64 + static_cast<std::size_t>(bit)]);
+                    bits &= ~(std::uint64_t(1) << bit);
+                }
+            }
+            return SmartEnumErrc::None;
+        }
+
+        // Largest flags first, as for integral values
+        ValueType remainingValue = value;
+        for (auto it = index.byValue.rbegin(); it != index.byValue.rend() && remainingValue.Any(); ++it)
+        {
+            if (it->value.Any() && remainingValue.HasAll(it->value))
+            {
+                onFlag(it->instance);
+                remainingValue &= ~it->value;
+            }
+        }
+
+        return remainingValue.None() ? SmartEnumErrc::None : SmartEnumErrc::InvalidFlagValue;
+    }
+
+    static SmartEnumErrc decodeValue(const ValueType &value, std::vector<const TEnum *> *outResult)
+    {
+        if (!outResult)
+        {
+            return walkValue(value, [](const TEnum *) {});
+        }
+        return walkValue(value, [outResult](const TEnum *flag) { outResult->push_back(flag); });
+    }
+
+    /**
+     * @brief Same names and order as decodeValue(); @p outStr is untouched on error.
+     */
+    static SmartEnumErrc formatValue(const ValueType &value, std::string &outStr)
+    {
+        const SmartEnumErrc error = decodeValue(value, nullptr);
+        if (error != SmartEnumErrc::None)
+        {
+            return error;
+        }
+        outStr.clear();
+        walkValue(value, [&outStr](const TEnum *flag)
+        {
+            if (!outStr.empty())
+            {
+                outStr += ", ";
+            }
+            outStr += flag->Name();
+        });
+        return SmartEnumErrc::None;
+    }
+};
+
+/**
+ * @brief Combining wide flag instances yields their FlagBitset.
+ */
+template <typename TEnum, std::size_t Bits>
+inline FlagBitset<Bits> operator|(const SmartFlagEnum<TEnum, FlagBitset<Bits>> &a,
+                                  const SmartFlagEnum<TEnum, FlagBitset<Bits>> &b)
+{
+    return a.Value() | b.Value();
+}
+
+template <typename TEnum, std::size_t Bits>
+inline FlagBitset<Bits> operator&(const SmartFlagEnum<TEnum, FlagBitset<Bits>> &a,
+                                  const SmartFlagEnum<TEnum, FlagBitset<Bits>> &b)
+{
+    return a.Value() & b.Value();
+}
+
+template <typename TEnum, std::size_t Bits>
+inline FlagBitset<Bits> operator^(const SmartFlagEnum<TEnum, FlagBitset<Bits>> &a,
+                                  const SmartFlagEnum<TEnum, FlagBitset<Bits>> &b)
+{
+    return a.Value() ^ b.Value();
+}
+
+template <typename TEnum, std::size_t Bits>
+inline FlagBitset<Bits> operator~(const SmartFlagEnum<TEnum, FlagBitset<Bits>> &a)
+{
+    return ~a.Value();
+}
+
+#endif // SMARTENUM_DETAIL_WIDESMARTFLAGENUM_HPP
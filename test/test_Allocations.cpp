@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include "SmartEnumCpp/SmartEnum.hpp"
+#include "SmartEnumCpp/SmartFlagEnum.hpp"
+#include "SmartEnumCpp/SmartEnumSwitch.hpp"
+#include "SmartEnumCpp/EnumDispatcher.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts every global allocation so lookups can assert they stay off the heap.
+// The replacements are kept out of line so the compiler does not pair the inlined
+// malloc/free with the standard operators.
+static std::atomic<size_t> allocationCount{0};
+
+#if defined(__GNUC__)
+#define TEST_NOINLINE __attribute__((noinline))
+#else
+#define TEST_NOINLINE
+#endif
+
+TEST_NOINLINE void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+TEST_NOINLINE void operator delete(void *p) noexcept { std::free(p); }
+TEST_NOINLINE void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+class Token : public SmartEnum<Token>
+{
+public:
+    static const Token Get;
+    static const Token Post;
+    static const Token Delete;
+
+private:
+    Token(const std::string &name, int value) : SmartEnum(name, value) {}
+};
+const Token Token::Get("GET", 1);
+const Token Token::Post("POST", 2);
+const Token Token::Delete("DELETE", 3);
+
+class TokenFlags : public SmartFlagEnum<TokenFlags>
+{
+public:
+    static const TokenFlags Secure;
+    static const TokenFlags HttpOnly;
+
+private:
+    TokenFlags(const std::string &name, int value) : SmartFlagEnum(name, value) {}
+};
+const TokenFlags TokenFlags::Secure("Secure", 1);
+const TokenFlags TokenFlags::HttpOnly("HttpOnly", 2);
+
+class HeaderName : public SmartEnum<HeaderName>
+{
+public:
+    static const HeaderName ContentType;
+    static const HeaderName ContentLength;
+    static const HeaderName XForwardedFor;
+
+private:
+    HeaderName(const std::string &name, int value) : SmartEnum(name, value) {}
+};
+const HeaderName HeaderName::ContentType("Content-Type", 1);
+const HeaderName HeaderName::ContentLength("Content-Length", 2);
+const HeaderName HeaderName::XForwardedFor("X-Forwarded-For", 3);
+
+TEST(AllocationTest, StringViewNameLookup)
+{
+    const char buffer[] = "POST /index.html";
+    std::string_view method(buffer, 4);
+
+    // Warm up lazily built indexes before counting.
+    const Token *out = nullptr;
+    ASSERT_TRUE(Token::TryFromName(method, out));
+
+    size_t before = allocationCount.load();
+    EXPECT_TRUE(Token::TryFromName(method, out));
+    EXPECT_EQ(out, &Token::Post);
+    EXPECT_TRUE(Token::TryFromName(buffer, 4, out));
+    EXPECT_EQ(out, &Token::Post);
+    EXPECT_TRUE(Token::TryFromName("post", out, true));
+    EXPECT_EQ(out, &Token::Post);
+    EXPECT_FALSE(Token::TryFromName(std::string_view("PUT"), out));
+    EXPECT_FALSE(Token::TryFromName("a-name-longer-than-any-registered-one", out, true));
+    EXPECT_EQ(&Token::Delete, &Token::FromName(std::string_view("delete"), true));
+    EXPECT_EQ(&Token::Get, &Token::FromName("GET /", 3));
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST(AllocationTest, StringViewFlagNameLookup)
+{
+    std::vector<const TokenFlags *> out;
+    out.reserve(4);
+    ASSERT_TRUE(TokenFlags::TryFromName("Secure", out));
+
+    size_t before = allocationCount.load();
+    EXPECT_TRUE(TokenFlags::TryFromName(std::string_view("Secure, HttpOnly"), out));
+    EXPECT_EQ(out.size(), 2u);
+    EXPECT_TRUE(TokenFlags::TryFromName("secure,httponly", out, true));
+    EXPECT_EQ(out.size(), 2u);
+    EXPECT_FALSE(TokenFlags::TryFromName("Secure, SameSite", out));
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST(AllocationTest, CaseInsensitiveHeaderLookup)
+{
+    const HeaderName *out = nullptr;
+    ASSERT_TRUE(HeaderName::TryFromName("content-type", out, true));
+
+    size_t before = allocationCount.load();
+    EXPECT_TRUE(HeaderName::TryFromName("CONTENT-LENGTH", out, true));
+    EXPECT_EQ(out, &HeaderName::ContentLength);
+    EXPECT_TRUE(HeaderName::TryFromName("x-forwarded-for", out, true));
+    EXPECT_EQ(out, &HeaderName::XForwardedFor);
+    EXPECT_FALSE(HeaderName::TryFromName("x-forwarded-host", out, true));
+    EXPECT_FALSE(HeaderName::TryFromName("content-type ", out, true));
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST(AllocationTest, FindMissesDoNotAllocate)
+{
+    ASSERT_TRUE(Token::FindName("GET"));
+    ASSERT_TRUE(TokenFlags::FindName("Secure"));
+
+    size_t before = allocationCount.load();
+    auto name = Token::FindName("PATCH");
+    EXPECT_FALSE(name);
+    EXPECT_EQ(name.Error(), SmartEnumErrc::NameNotFound);
+    EXPECT_EQ(Token::FindValue(42).Error(), SmartEnumErrc::ValueNotFound);
+    EXPECT_EQ(&Token::FindName("post", true).Value(), &Token::Post);
+    EXPECT_EQ(TokenFlags::FindName("Secure, SameSite").Error(), SmartEnumErrc::NameNotFound);
+    EXPECT_EQ(TokenFlags::FindValue(4).Error(), SmartEnumErrc::InvalidFlagValue);
+    EXPECT_EQ(TokenFlags::FindValue(-1).Error(), SmartEnumErrc::NegativeFlagValue);
+    EXPECT_EQ(TokenFlags::FindValueToString(8).Error(), SmartEnumErrc::InvalidFlagValue);
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST(AllocationTest, CombinedFlagDecode)
+{
+    std::vector<const TokenFlags *> out;
+    out.reserve(4);
+    ASSERT_TRUE(TokenFlags::TryFromValue(3, out));
+
+    size_t before = allocationCount.load();
+    EXPECT_TRUE(TokenFlags::TryFromValue(3, out));
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0], &TokenFlags::HttpOnly);
+    EXPECT_EQ(out[1], &TokenFlags::Secure);
+    EXPECT_FALSE(TokenFlags::TryFromValue(5, out));
+    EXPECT_TRUE(out.empty());
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST(AllocationTest, DecomposeDoesNotAllocate)
+{
+    ASSERT_TRUE(TokenFlags::FindValue(1));
+
+    size_t before = allocationCount.load();
+    int visited = 0;
+    for (const TokenFlags &flag : TokenFlags::Decompose(3))
+    {
+        visited += flag.Value();
+    }
+    EXPECT_EQ(visited, 3);
+    EXPECT_EQ(TokenFlags::Decompose(6).UnmatchedBits(), 4);
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST(AllocationTest, FlagSetChecksDoNotAllocate)
+{
+    size_t before = allocationCount.load();
+    FlagSet<TokenFlags> cookie = TokenFlags::Secure | TokenFlags::HttpOnly;
+    EXPECT_TRUE(cookie.HasFlag(TokenFlags::HttpOnly));
+    cookie &= ~TokenFlags::Secure;
+    EXPECT_FALSE(cookie.HasAny(TokenFlags::Secure));
+    EXPECT_EQ(cookie.Count(), 1);
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST(AllocationTest, FlagNamesIntoMask)
+{
+    int mask = 0;
+    ASSERT_TRUE(TokenFlags::TryFromName("Secure", mask));
+
+    size_t before = allocationCount.load();
+    EXPECT_TRUE(TokenFlags::TryFromName(" Secure | HttpOnly ", mask));
+    EXPECT_EQ(mask, 3);
+    EXPECT_TRUE(TokenFlags::TryFromName("httponly", mask, true));
+    EXPECT_EQ(mask, 2);
+    EXPECT_FALSE(TokenFlags::TryFromName("Secure|SameSite", mask));
+    FlagSet<TokenFlags> flags;
+    EXPECT_TRUE(TokenFlags::TryFromName("Secure,HttpOnly", flags));
+    EXPECT_EQ(flags.Value(), 3);
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST(AllocationTest, MatchDoesNotAllocate)
+{
+    // Captures bigger than std::function's small buffer would have gone to the heap
+    const long weights[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    size_t before = allocationCount.load();
+    const long total = Match<long>(Token::Post)
+                           .When(Token::Get, [weights] { return weights[0]; })
+                           .When(Token::Post, [weights] { return weights[1] + weights[7]; })
+                           .Otherwise([] { return 0L; });
+    EXPECT_EQ(total, 10);
+    EXPECT_EQ(allocationCount.load(), before);
+}
+
+TEST(AllocationTest, ForEachFlagDoesNotAllocate)
+{
+    int seen = 0;
+    const auto onFlag = EnumDispatcher<TokenFlags, void(int &)>()
+                            .On(TokenFlags::Secure, [](int &mask)
+                                { mask |= 1; })
+                            .On(TokenFlags::HttpOnly, [](int &mask)
+                                { mask |= 2; });
+
+    size_t before = allocationCount.load();
+    EXPECT_EQ(ForEachFlag(TokenFlags::Secure | TokenFlags::HttpOnly, onFlag, seen), 0);
+    EXPECT_EQ(seen, 3);
+    EXPECT_EQ(ForEachFlag(6, onFlag, seen), 4);
+    EXPECT_EQ(allocationCount.load(), before);
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "SmartEnumCpp/SmartEnum.hpp"
+#include "SmartEnumCpp/SmartFlagEnum.hpp"
+
+#include <atomic>
+#include <deque>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Run under -fsanitize=thread to check the registry's concurrency contract.
+
+class Service : public SmartEnum<Service>
+{
+public:
+    static const Service &Http;
+    static const Service &Dns;
+
+    // Instances registered late live as long as the process, like static ones.
+    static const Service &Define(const std::string &name, int value) { return *new Service(name, value); }
+
+private:
+    Service(const std::string &name, int value) : SmartEnum(name, value) {}
+};
+const Service &Service::Http = Service::Define("Http", 80);
+const Service &Service::Dns = Service::Define("Dns", 53);
+
+class Feature : public SmartFlagEnum<Feature>
+{
+public:
+    static const Feature &Tls;
+    static const Feature &Ipv6;
+
+    static const Feature &Define(const std::string &name, int value) { return *new Feature(name, value); }
+
+private:
+    Feature(const std::string &name, int value) : SmartFlagEnum(name, value) {}
+};
+const Feature &Feature::Tls = Feature::Define("Tls", 1);
+const Feature &Feature::Ipv6 = Feature::Define("Ipv6", 2);
+
+TEST(ConcurrencyTest, LookupsWhileRegistering)
+{
+    constexpr int kWriters = 4;
+    constexpr int kPerWriter = 50;
+    constexpr int kReaders = 4;
+
+    std::atomic<bool> writing{true};
+    std::atomic<int> failures{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; ++r)
+    {
+        readers.emplace_back([&]
+        {
+            std::vector<const Feature *> flags;
+            do
+            {
+                // Static instances stay reachable through every republished index.
+                if (Service::FindName("Http").Get() != &Service::Http || !Service::FindValue(53) ||
+                    !Feature::TryFromValue(3, flags) || flags.size() != 2)
+                {
+                    ++failures;
+                }
+
+                // Every visible instance has the ordinal of its position.
+                const std::vector<const Service *> &list = Service::List();
+                for (std::size_t i = 0; i < list.size(); ++i)
+                {
+                    if (list[i]->Ordinal() != i)
+                    {
+                        ++failures;
+                    }
+                }
+            } while (writing.load());
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w)
+    {
+        writers.emplace_back([w]
+        {
+            for (int i = 0; i < kPerWriter; ++i)
+            {
+                const int id = w * kPerWriter + i;
+                const Service &service = Service::Define("Late" + std::to_string(id), 1000 + id);
+                Feature::Define("Late" + std::to_string(id), 1 << (2 + id % 20));
+                (void)service;
+            }
+        });
+    }
+    for (std::thread &writer : writers)
+    {
+        writer.join();
+    }
+    writing = false;
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(failures.load(), 0);
+    ASSERT_EQ(Service::Count(), 2u + kWriters * kPerWriter);
+    const std::vector<const Service *> &list = Service::List();
+    for (std::size_t i = 0; i < list.size(); ++i)
+    {
+        EXPECT_EQ(list[i]->Ordinal(), i);
+    }
+    EXPECT_EQ(Service::FromValue(1000 + kWriters * kPerWriter - 1).Name(),
+              "Late" + std::to_string(kWriters * kPerWriter - 1));
+}
+
+TEST(ConcurrencyTest, ReferencesSurviveLateRegistration)
+{
+    const std::vector<const Service *> &before = Service::List();
+    const std::size_t size = before.size();
+    Service::Define("AfterFreeze", 5000);
+
+    // The old snapshot is retained, not rebuilt in place.
+    EXPECT_EQ(before.size(), size);
+    EXPECT_EQ(Service::List().size(), size + 1);
+    EXPECT_EQ(Service::FromName("AfterFreeze").Value(), 5000);
+}
+
+// Minimal instance type for driving a registry directly
+struct Entry
+{
+    std::string name;
+    int value;
+    std::string_view Name() const { return name; }
+    int Value() const { return value; }
+};
+
+TEST(ConcurrencyTest, LateFreezesShareLookupTables)
+{
+    SmartEnumDetail::Registry<Entry, int> registry;
+    std::deque<Entry> entries;
+    std::size_t ordinal = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        entries.push_back(Entry{"Base" + std::to_string(i), i});
+        ASSERT_TRUE(registry.Register(&entries.back(), ordinal));
+    }
+    const auto *baseTables = registry.Lookup().tables.get();
+
+    // One freeze per late registration; the tables are rebuilt only once the tail
+    // exceeds half of what they cover: at 13, 20, 31, 47, 71 and 107 instances
+    std::set<const void *> tables{baseTables};
+    for (int i = 0; i < 100; ++i)
+    {
+        entries.push_back(Entry{"Late" + std::to_string(i), 100 + i});
+        ASSERT_TRUE(registry.Register(&entries.back(), ordinal));
+        const auto &index = registry.Lookup();
+        tables.insert(index.tables.get());
+        ASSERT_EQ(index.FindName("Late" + std::to_string(i)), &entries.back());
+        ASSERT_EQ(index.FindNameIgnoreCase("LATE" + std::to_string(i)), &entries.back());
+        ASSERT_EQ(index.FindValue(100 + i), &entries.back());
+        ASSERT_EQ(index.FindName("Base3"), &entries[3]);
+        ASSERT_EQ(index.FindValue(3), &entries[3]);
+        EXPECT_EQ(index.FindName("Missing"), nullptr);
+        EXPECT_EQ(index.FindValue(99), nullptr);
+        EXPECT_LE(index.instances.size() - index.tables->indexed, index.tables->indexed / 2);
+    }
+    EXPECT_EQ(tables.size(), 7u);
+
+    // A late name that differs from an earlier one only in case resolves to the earlier one
+    entries.push_back(Entry{"base0", 500});
+    ASSERT_TRUE(registry.Register(&entries.back(), ordinal));
+    EXPECT_EQ(registry.Lookup().FindNameIgnoreCase("BASE0"), &entries[0]);
+    EXPECT_EQ(registry.Lookup().FindName("base0"), &entries.back());
+}
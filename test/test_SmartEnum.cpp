@@ -1,7 +1,18 @@
 #include <gtest/gtest.h>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <thread>
 #include "SmartEnumCpp/SmartEnum.hpp"
 #include "SmartEnumCpp/SmartFlagEnum.hpp"
 #include "SmartEnumCpp/SmartEnumSwitch.hpp"
+#include "SmartEnumCpp/EnumDispatcher.hpp"
+#include "SmartEnumCpp/PerfectNameHash.hpp"
+#include "SmartEnumCpp/EnumMap.hpp"
+#include "SmartEnumCpp/EnumSet.hpp"
+#include "SmartEnumCpp/ConstexprSmartEnum.hpp"
+#include "SmartEnumCpp/FlagStringCache.hpp"
+#include "SmartEnumCpp/AtomicFlagSet.hpp"
 
 // Define a simple TestEnum for testing
 class TestEnum : public SmartEnum<TestEnum>
@@ -85,6 +96,90 @@ public:
 const SparseFlags &SparseFlags::Bit1 = SparseFlags("Bit1", 1);
 const SparseFlags &SparseFlags::Bit3 = SparseFlags("Bit3", 4);
 
+class LedFlags : public SmartFlagEnum<LedFlags, uint8_t>
+{
+public:
+    static const LedFlags &Red;
+    static const LedFlags &Green;
+    static const LedFlags &Blue;
+    LedFlags(const std::string &name, uint8_t value) : SmartFlagEnum(name, value) {}
+};
+const LedFlags &LedFlags::Red = LedFlags("Red", 1);
+const LedFlags &LedFlags::Green = LedFlags("Green", 2);
+const LedFlags &LedFlags::Blue = LedFlags("Blue", 4);
+
+// Same definitions twice: decoded through the full lookup table, and decoded on demand.
+class StatusRegister : public SmartFlagEnum<StatusRegister, uint8_t>, public UseFlagEnumLookupTable
+{
+public:
+    StatusRegister(const std::string &name, uint8_t value) : SmartFlagEnum(name, value) {}
+};
+class StatusRegisterUntabled : public SmartFlagEnum<StatusRegisterUntabled, uint8_t>
+{
+public:
+    StatusRegisterUntabled(const std::string &name, uint8_t value) : SmartFlagEnum(name, value) {}
+};
+const StatusRegister statusRegisterFlags[] = {{"Idle", 0}, {"Ready", 1}, {"Busy", 2}, {"ReadyBusy", 3},
+                                              {"Error", 0x10}, {"Fault", 0x60}};
+const StatusRegisterUntabled statusRegisterUntabledFlags[] = {{"Idle", 0}, {"Ready", 1}, {"Busy", 2}, {"ReadyBusy", 3},
+                                                              {"Error", 0x10}, {"Fault", 0x60}};
+
+// 16 bits and 24 pairs: more distinct values than the lookup table can refer to.
+class BusRegister : public SmartFlagEnum<BusRegister, uint16_t>, public UseFlagEnumLookupTable
+{
+public:
+    BusRegister(const std::string &name, uint16_t value) : SmartFlagEnum(name, value) {}
+};
+class BusRegisterUntabled : public SmartFlagEnum<BusRegisterUntabled, uint16_t>
+{
+public:
+    BusRegisterUntabled(const std::string &name, uint16_t value) : SmartFlagEnum(name, value) {}
+};
+template <typename TRegister>
+static bool defineBusRegister()
+{
+    for (int bit = 0; bit < 16; ++bit)
+    {
+        new TRegister("Line" + std::to_string(bit), static_cast<uint16_t>(1u << bit));
+    }
+    for (int bit = 0; bit < 24; ++bit)
+    {
+        new TRegister("Pair" + std::to_string(bit), static_cast<uint16_t>(3u << (bit % 15)) | (bit / 15));
+    }
+    return true;
+}
+const bool busRegisterDefined = defineBusRegister<BusRegister>() && defineBusRegister<BusRegisterUntabled>();
+
+// More flags than fit in a 64-bit value
+class Capability : public SmartFlagEnum<Capability, FlagBitset<150>>
+{
+public:
+    static const Capability &Base;
+    static const Capability &Word0Top;
+    static const Capability &Word1Bottom;
+    static const Capability &Last;
+    static const Capability &Edges; // explicit combination (Base|Last)
+    Capability(const std::string &name, ValueType value) : SmartFlagEnum(name, value) {}
+};
+const Capability &Capability::Base = Capability("Base", Capability::ValueType::Bit(0));
+const Capability &Capability::Word0Top = Capability("Word0Top", Capability::ValueType::Bit(63));
+const Capability &Capability::Word1Bottom = Capability("Word1Bottom", Capability::ValueType::Bit(64));
+const Capability &Capability::Last = Capability("Last", Capability::ValueType::Bit(149));
+const Capability &Capability::Edges = Capability("Edges", Capability::ValueType::Bit(0) | Capability::ValueType::Bit(149));
+
+// Only single-bit flags, spread over three words: decoded by walking the words
+class Lane : public SmartFlagEnum<Lane, FlagBitset<150>>
+{
+public:
+    static const Lane &Low;
+    static const Lane &Mid;
+    static const Lane &High;
+    Lane(const std::string &name, ValueType value) : SmartFlagEnum(name, value) {}
+};
+const Lane &Lane::Low = *new Lane("Low", Lane::Flag<1>());
+const Lane &Lane::Mid = *new Lane("Mid", Lane::Flag<70>());
+const Lane &Lane::High = *new Lane("High", Lane::Flag<140>());
+
 // Namespaces for testing enums with the same name
 namespace FirstNamespace {
     class Direction : public SmartEnum<Direction> {
@@ -168,6 +263,112 @@ namespace SecondNamespace {
     const Options Options::All("All", -1);  // Uses negative values (not allowed in FirstNamespace)
 }
 
+// Signed 8-bit enum whose values straddle zero (dense value index)
+class Level : public SmartEnum<Level, int8_t>
+{
+public:
+    static const Level Low;
+    static const Level BelowNormal;
+    static const Level Normal;
+    static const Level High;
+
+private:
+    Level(const std::string &name, int8_t value) : SmartEnum(name, value) {}
+};
+const Level Level::Low("Low", -2);
+const Level Level::BelowNormal("BelowNormal", -1);
+const Level Level::Normal("Normal", 0);
+const Level Level::High("High", 2);
+
+// Enum with a public constructor so tests can register instances after a freeze
+class LateEnum : public SmartEnum<LateEnum>
+{
+public:
+    static const LateEnum Early;
+    LateEnum(const std::string &name, int value) : SmartEnum(name, value) {}
+};
+const LateEnum LateEnum::Early("Early", 1);
+
+// Enum declaring its names up front for the compile-time perfect hash
+class Planet : public SmartEnum<Planet>
+{
+public:
+    static constexpr auto NameHash = MakePerfectNameHash("Mercury", "Venus", "Earth", "Mars", "Jupiter");
+    static const Planet Mercury;
+    static const Planet Venus;
+    static const Planet Earth;
+    static const Planet Mars;
+    static const Planet Jupiter;
+
+private:
+    Planet(const std::string &name, int value) : SmartEnum(name, value) {}
+};
+const Planet Planet::Mercury("Mercury", 1);
+const Planet Planet::Venus("Venus", 2);
+const Planet Planet::Earth("Earth", 3);
+const Planet Planet::Mars("Mars", 4);
+const Planet Planet::Jupiter("Jupiter", 5);
+
+// Declares fewer names than it registers, so lookups must not rely on the hash
+class PartialPlanet : public SmartEnum<PartialPlanet>
+{
+public:
+    static constexpr auto NameHash = MakePerfectNameHash("Saturn");
+    static const PartialPlanet Saturn;
+    static const PartialPlanet Uranus;
+
+private:
+    PartialPlanet(const std::string &name, int value) : SmartEnum(name, value) {}
+};
+const PartialPlanet PartialPlanet::Saturn("Saturn", 6);
+const PartialPlanet PartialPlanet::Uranus("Uranus", 7);
+
+// Enum whose instances and lookup tables are all built at compile time
+class Season : public ConstexprSmartEnum<Season, uint8_t>
+{
+public:
+    static const std::array<Season, 4> Definitions;
+    static const Season &Winter;
+    static const Season &Spring;
+    static const Season &Summer;
+    static const Season &Autumn;
+
+private:
+    constexpr Season(std::string_view name, uint8_t value) : ConstexprSmartEnum(name, value) {}
+};
+
+constexpr std::array<Season, 4> Season::Definitions = {
+    Season("Winter", 12),
+    Season("Spring", 3),
+    Season("Summer", 6),
+    Season("Autumn", 9),
+};
+constexpr const Season &Season::Winter = Season::Definitions[0];
+constexpr const Season &Season::Spring = Season::Definitions[1];
+constexpr const Season &Season::Summer = Season::Definitions[2];
+constexpr const Season &Season::Autumn = Season::Definitions[3];
+
+// Enum with more instances than fit in one 64-bit word
+class WideEnum : public SmartEnum<WideEnum>
+{
+public:
+    WideEnum(const std::string &name, int value) : SmartEnum(name, value) {}
+
+    static const std::deque<WideEnum> &Instances()
+    {
+        static const std::deque<WideEnum> instances = []
+        {
+            std::deque<WideEnum> created;
+            for (int i = 0; i < 70; ++i)
+            {
+                created.emplace_back("Wide" + std::to_string(i), i);
+            }
+            return created;
+        }();
+        return instances;
+    }
+};
+
 // Tests for SmartEnum functionality
 TEST(SmartEnumTest, LookupByNameAndValue)
 {
@@ -186,6 +387,103 @@ TEST(SmartEnumTest, LookupByNameAndValue)
     EXPECT_FALSE(TestEnum::TryFromValue(42, outEnum));
 }
 
+TEST(SmartEnumTest, DenseAndSparseValueLookup)
+{
+    // Dense range with a hole at 1 and values on both sides of zero
+    EXPECT_EQ(&Level::Low, &Level::FromValue(-2));
+    EXPECT_EQ(&Level::Normal, &Level::FromValue(0));
+    EXPECT_EQ(&Level::High, &Level::FromValue(2));
+    const Level *outLevel = nullptr;
+    EXPECT_FALSE(Level::TryFromValue(1, outLevel));
+    EXPECT_FALSE(Level::TryFromValue(-3, outLevel));
+    EXPECT_FALSE(Level::TryFromValue(127, outLevel));
+    EXPECT_FALSE(Level::TryFromValue(-128, outLevel));
+
+    // Sparse range (10..40) is served from the value hash
+    for (const SecondNamespace::Direction *direction : SecondNamespace::Direction::List())
+    {
+        EXPECT_EQ(direction, &SecondNamespace::Direction::FromValue(direction->Value()));
+    }
+    const SecondNamespace::Direction *outDirection = nullptr;
+    for (int missing : {0, 11, 25, 41, -10, std::numeric_limits<int>::min(), std::numeric_limits<int>::max()})
+    {
+        EXPECT_FALSE(SecondNamespace::Direction::TryFromValue(missing, outDirection)) << missing;
+    }
+}
+
+TEST(SmartEnumTest, FreezeAndLateRegistration)
+{
+    LateEnum::Freeze();
+    EXPECT_EQ(LateEnum::List().size(), 1);
+    EXPECT_EQ(&LateEnum::Early, &LateEnum::FromValue(1));
+
+    EnumMap<LateEnum, int> earlyMap;
+
+    // Registering after the freeze is folded into the next lookup.
+    static const LateEnum late("Late", 2);
+    EXPECT_THROW(earlyMap.At(late), std::out_of_range);
+    EXPECT_EQ(LateEnum::List().size(), 2);
+    EXPECT_EQ(&late, &LateEnum::FromName("late", true));
+    EXPECT_EQ(&late, &LateEnum::FromValue(2));
+
+    // Duplicate names are still rejected against the frozen index.
+    EXPECT_THROW(LateEnum("Early", 3), std::runtime_error);
+    EXPECT_EQ(LateEnum::List().size(), 2);
+
+    // A rejected registration does not consume an ordinal.
+    static const LateEnum later("Later", 3);
+    EXPECT_EQ(later.Ordinal(), 2);
+    EXPECT_EQ(LateEnum::Count(), 3);
+}
+
+TEST(SmartEnumTest, OrdinalAndCount)
+{
+    EXPECT_EQ(TestEnum::Count(), 3);
+    EXPECT_EQ(TestEnum::One.Ordinal(), 0);
+    EXPECT_EQ(TestEnum::Two.Ordinal(), 1);
+    EXPECT_EQ(TestEnum::Three.Ordinal(), 2);
+    for (std::size_t i = 0; i < TestEnum::Count(); ++i)
+    {
+        EXPECT_EQ(TestEnum::List()[i]->Ordinal(), i);
+    }
+
+    EXPECT_EQ(EmployeeType::Count(), 2);
+    EXPECT_EQ(EmployeeType::Assistant.Ordinal(), 1);
+
+    EXPECT_EQ(Flags::Count(), 6);
+    EXPECT_EQ(Flags::None.Ordinal(), 0);
+    EXPECT_EQ(Flags::All.Ordinal(), 5);
+    EXPECT_EQ(Flags::List()[Flags::AB.Ordinal()], &Flags::AB);
+}
+
+TEST(SmartEnumTest, PerfectNameHashLookup)
+{
+    static_assert(Planet::NameHash.Find("Mars") == 3, "hash is built at compile time");
+    static_assert(Planet::NameHash.FindIgnoreCase("JUPITER") == 4, "folded hash is built at compile time");
+    static_assert(Planet::NameHash.Find("Pluto") == PerfectNameHash<5>::npos, "unknown names miss");
+
+    EXPECT_EQ(&Planet::Earth, &Planet::FromName("Earth"));
+    EXPECT_EQ(&Planet::Venus, &Planet::FromName("vENUS", true));
+    const Planet *outPlanet = nullptr;
+    EXPECT_FALSE(Planet::TryFromName("earth", outPlanet));
+    EXPECT_FALSE(Planet::TryFromName("Pluto", outPlanet, true));
+
+    EXPECT_EQ(&PartialPlanet::Uranus, &PartialPlanet::FromName("Uranus"));
+    EXPECT_EQ(&PartialPlanet::Saturn, &PartialPlanet::FromName("SATURN", true));
+}
+
+TEST(SmartEnumTest, AsciiCaseFolding)
+{
+    using SmartEnumDetail::CompareIgnoreCase;
+    EXPECT_EQ(0, CompareIgnoreCase("Content-Length", "CONTENT-LENGTH"));
+    EXPECT_LT(CompareIgnoreCase("content-length", "CONTENT-TYPE"), 0);
+    EXPECT_GT(CompareIgnoreCase("ABCDEFGHIJKLMNOPQRSTUVWXYZ[", "abcdefghijklmnopqrstuvwxyz@"), 0);
+    EXPECT_LT(CompareIgnoreCase("Short", "shorter"), 0);
+    // Only ASCII letters fold; '@' and '`' sit right next to the letter ranges.
+    EXPECT_NE(0, CompareIgnoreCase("@@@@@@@@@", "`````````"));
+    EXPECT_NE(0, CompareIgnoreCase("\xC3\x84rger", "\xE3\xA4rger"));
+}
+
 TEST(SmartEnumTest, EqualityAndToString)
 {
     EXPECT_TRUE(TestEnum::One.Equals(TestEnum::One));
@@ -198,6 +496,185 @@ TEST(SmartEnumTest, PolymorphicBehavior)
     EXPECT_EQ(500, EmployeeType::Assistant.BonusSize());
 }
 
+TEST(SmartEnumTest, EnumMapStorage)
+{
+    EnumMap<TestEnum, int> counts;
+    EXPECT_EQ(counts.Size(), TestEnum::Count());
+    EXPECT_EQ(counts[TestEnum::Two], 0);
+    counts[TestEnum::Two] += 2;
+    counts.At(TestEnum::Three) = 3;
+    EXPECT_EQ(&counts[TestEnum::Two] + 1, &counts[TestEnum::Three]);
+
+    std::vector<std::string> names;
+    int total = 0;
+    for (auto [key, count] : counts)
+    {
+        names.push_back(key.Name());
+        total += count;
+        count = 0;
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"One", "Two", "Three"}));
+    EXPECT_EQ(total, 5);
+    EXPECT_EQ(counts[TestEnum::Three], 0);
+
+    // Polymorphic instances are keyed through the base reference.
+    const EnumMap<EmployeeType, std::string> titles = {
+        {EmployeeType::Assistant, "PA"},
+    };
+    EXPECT_EQ(titles[EmployeeType::Manager], "");
+    EXPECT_EQ(titles.At(EmployeeType::Assistant), "PA");
+    EXPECT_EQ((*titles.begin()).first.BonusSize(), 1000);
+
+    EnumMap<Flags, bool> seen(true);
+    seen[Flags::AB] = false;
+    EXPECT_FALSE(seen[Flags::AB]);
+    EXPECT_TRUE(seen.At(Flags::All));
+}
+
+TEST(SmartEnumTest, EnumMapOfBool)
+{
+    // bool entries are real bools, not std::vector<bool> bit proxies
+    EnumMap<TestEnum, bool> enabled;
+    static_assert(std::is_same<decltype(enabled[TestEnum::One]), bool &>::value, "operator[] yields bool&");
+    bool &two = enabled[TestEnum::Two];
+    two = true;
+    EXPECT_TRUE(enabled.At(TestEnum::Two));
+    EXPECT_EQ(&enabled[TestEnum::One] + 1, &two);
+
+    for (auto [key, on] : enabled)
+    {
+        static_assert(std::is_same<decltype(on), bool &>::value, "iteration yields bool&");
+        on = !on;
+        (void)key;
+    }
+    EXPECT_TRUE(enabled[TestEnum::One]);
+    EXPECT_FALSE(enabled[TestEnum::Two]);
+
+    // Copies are deep
+    EnumMap<TestEnum, bool> copy = enabled;
+    copy[TestEnum::One] = false;
+    EXPECT_TRUE(enabled[TestEnum::One]);
+    copy = enabled;
+    EXPECT_TRUE(copy[TestEnum::One]);
+    EXPECT_EQ(copy.Size(), TestEnum::Count());
+
+    // A moved-from map is empty and still safe to copy, fill and iterate
+    EnumMap<TestEnum, bool> moved = std::move(copy);
+    EXPECT_EQ(moved.Size(), TestEnum::Count());
+    EXPECT_TRUE(moved[TestEnum::One]);
+    EXPECT_EQ(copy.Size(), 0u);
+    EXPECT_TRUE(copy.begin() == copy.end());
+    copy.Fill(true);
+    EnumMap<TestEnum, bool> fromMoved = copy;
+    EXPECT_EQ(fromMoved.Size(), 0u);
+    enabled = std::move(moved);
+    EXPECT_EQ(moved.Size(), 0u);
+    const EnumMap<TestEnum, bool> copyOfMoved(moved);
+    EXPECT_TRUE(copyOfMoved.begin() == copyOfMoved.end());
+    moved = enabled;
+    EXPECT_EQ(moved.Size(), TestEnum::Count());
+}
+
+TEST(SmartEnumTest, EnumSetAlgebra)
+{
+    static_assert(EnumSet<TestEnum>().Empty(), "empty sets are constexpr");
+    static_assert(sizeof(EnumSet<TestEnum>) == sizeof(std::uint64_t), "one word by default");
+
+    const EnumSet<TestEnum> low(TestEnum::One, TestEnum::Two);
+    const EnumSet<TestEnum> odd(TestEnum::One, TestEnum::Three);
+    EXPECT_TRUE(low.Contains(TestEnum::Two));
+    EXPECT_FALSE(low.Contains(TestEnum::Three));
+    EXPECT_EQ(low.Size(), 2);
+
+    EXPECT_EQ(low | odd, EnumSet<TestEnum>::All());
+    EXPECT_EQ(low & odd, EnumSet<TestEnum>(TestEnum::One));
+    EXPECT_EQ(low - odd, EnumSet<TestEnum>(TestEnum::Two));
+    EXPECT_EQ(low ^ odd, (EnumSet<TestEnum>(TestEnum::Two, TestEnum::Three)));
+    EXPECT_TRUE((low - low).Empty());
+
+    std::vector<const TestEnum *> members;
+    for (const TestEnum &member : odd)
+    {
+        members.push_back(&member);
+    }
+    EXPECT_EQ(members, (std::vector<const TestEnum *>{&TestEnum::One, &TestEnum::Three}));
+
+    EnumSet<EmployeeType> staff;
+    staff.Insert(EmployeeType::Assistant);
+    EXPECT_EQ(staff.begin()->BonusSize(), 500);
+    staff.Erase(EmployeeType::Assistant);
+    EXPECT_TRUE(staff.Empty());
+
+    EnumSet<TestEnum, 2> tooSmall;
+    EXPECT_THROW(tooSmall.Insert(TestEnum::Three), std::out_of_range);
+    EXPECT_FALSE(tooSmall.Contains(TestEnum::Three));
+}
+
+TEST(SmartEnumTest, ConstexprLookup)
+{
+    static_assert(Season::Count() == 4, "count is a constant");
+    static_assert(Season::Autumn.Ordinal() == 3, "ordinal is the Definitions index");
+    // Ordinal() is only meaningful for the Definitions elements, so no copy can exist
+    static_assert(!std::is_copy_constructible<Season>::value, "instances are not copyable");
+    static_assert(!std::is_copy_assignable<Season>::value, "instances are not assignable");
+    constexpr auto ordinalOf = [](const Season &season) { return season.Ordinal(); };
+    static_assert(ordinalOf(Season::Summer) == 2, "references keep the ordinal");
+    static_assert(&Season::FromName("Summer") == &Season::Summer, "name lookup at compile time");
+    static_assert(&Season::FromName("SPRING", true) == &Season::Spring, "case-insensitive lookup");
+    static_assert(&Season::FromValue(12) == &Season::Winter, "value lookup at compile time");
+    static_assert(Season::List()[1] == &Season::Spring, "list is in definition order");
+    static_assert(EnumSet<Season>(Season::Winter, Season::Summer).Contains(Season::Summer), "constexpr set");
+    static_assert(!EnumSet<Season>(Season::Winter).Contains(Season::Autumn), "constexpr set");
+
+    EXPECT_EQ(Season::FromName("Winter").ToString(), "Winter");
+    EXPECT_EQ(&Season::FromName(std::string("autumn"), true), &Season::Autumn);
+    EXPECT_THROW(Season::FromName("Monsoon"), SmartEnumNotFoundException);
+    EXPECT_THROW(Season::FromValue(1), SmartEnumNotFoundException);
+    const Season *outSeason = nullptr;
+    EXPECT_FALSE(Season::TryFromName("winter", outSeason));
+    EXPECT_TRUE(Season::TryFromValue(6, outSeason));
+    EXPECT_EQ(outSeason, &Season::Summer);
+
+    int total = 0;
+    for (const Season *season : Season::List())
+    {
+        total += season->Value();
+    }
+    EXPECT_EQ(total, 30);
+
+    EnumMap<Season, int> days{{Season::Spring, 92}};
+    EXPECT_EQ(days[Season::Spring], 92);
+}
+
+TEST(SmartEnumTest, EnumSetAcrossWords)
+{
+    const auto &wide = WideEnum::Instances();
+    EnumSet<WideEnum, 128> set(wide[3], wide[63], wide[64], wide[69]);
+    EXPECT_EQ(set.Size(), 4);
+    EXPECT_TRUE(set.Contains(wide[64]));
+    EXPECT_FALSE(set.Contains(wide[65]));
+
+    std::vector<std::size_t> ordinals;
+    for (auto it = set.begin(); it != set.end(); ++it)
+    {
+        ordinals.push_back(it.Ordinal());
+    }
+    EXPECT_EQ(ordinals, (std::vector<std::size_t>{3, 63, 64, 69}));
+
+    EXPECT_EQ((EnumSet<WideEnum, 128>::All().Size()), 70);
+    EXPECT_THROW(EnumSet<WideEnum>::All(), std::out_of_range);
+
+    // One-word sets wrap the shift, so ordinals past the word must still test false
+    const EnumSet<WideEnum> word(wide[0], wide[5], wide[63]);
+    EXPECT_TRUE(word.Contains(wide[63]));
+    EXPECT_FALSE(word.Contains(wide[64]));
+    EXPECT_FALSE(word.Contains(wide[69]));
+    const EnumSet<WideEnum, 8> narrow(wide[0], wide[5]);
+    EXPECT_TRUE(narrow.Contains(wide[5]));
+    EXPECT_FALSE(narrow.Contains(wide[8]));
+    EXPECT_FALSE(narrow.Contains(wide[64]));
+}
+
 // Tests for SmartFlagEnum functionality
 TEST(SmartFlagEnumTest, CombinationAndExplicitValues)
 {
@@ -236,6 +713,401 @@ TEST(SmartFlagEnumTest, InvalidInputs)
     EXPECT_FALSE(NoNegFlags::TryFromValue(-5, res2));
 }
 
+TEST(SmartEnumTest, FindWithoutExceptions)
+{
+    auto one = TestEnum::FindName("One");
+    ASSERT_TRUE(one);
+    EXPECT_EQ(&*one, &TestEnum::One);
+    EXPECT_EQ(one->Value(), 1);
+    EXPECT_EQ(one.Error(), SmartEnumErrc::None);
+
+    auto missing = TestEnum::FindValue(99);
+    EXPECT_FALSE(missing.HasValue());
+    EXPECT_EQ(missing.Error(), SmartEnumErrc::ValueNotFound);
+    EXPECT_EQ(&missing.ValueOr(TestEnum::Three), &TestEnum::Three);
+    EXPECT_THROW(missing.Value(), SmartEnumBadResultAccess);
+    EXPECT_STREQ(ToString(missing.Error()), "value not found");
+    EXPECT_EQ(missing.Get(), nullptr);
+
+    const char buffer[] = "Two,Three";
+    EXPECT_EQ(TestEnum::FindName(buffer, 3).Get(), &TestEnum::Two);
+
+    // The pointer and length overloads take any integral length type alike
+    const uint16_t length = 3;
+    const TestEnum *parsed = nullptr;
+    EXPECT_EQ(&TestEnum::FromName(buffer, length), &TestEnum::Two);
+    EXPECT_TRUE(TestEnum::TryFromName(buffer, length, parsed));
+    EXPECT_EQ(parsed, &TestEnum::Two);
+    EXPECT_EQ(TestEnum::FindName(buffer, length).Get(), &TestEnum::Two);
+    std::vector<const Flags *> parsedFlags;
+    EXPECT_TRUE(Flags::TryFromName("A|B", uint8_t(1), parsedFlags));
+    const Season *season = nullptr;
+    EXPECT_TRUE(Season::TryFromName("Summer!", 6L, season));
+    EXPECT_EQ(season, &Season::Summer);
+    EXPECT_EQ(TestEnum::FindName("three", true).Get(), &TestEnum::Three);
+
+    auto flags = Flags::FindName("A, C");
+    ASSERT_TRUE(flags);
+    EXPECT_EQ(*flags, (std::vector<const Flags *>{&Flags::A, &Flags::C}));
+    EXPECT_EQ(Flags::FindValue(8).Error(), SmartEnumErrc::InvalidFlagValue);
+    EXPECT_EQ(Flags::FindValue(-1).Value(), std::vector<const Flags *>{&Flags::All});
+    EXPECT_EQ(NoNegFlags::FindValue(-5).Error(), SmartEnumErrc::NegativeFlagValue);
+    EXPECT_EQ(Flags::FindValueToString(5).ValueOr("?"), "C, A");
+    EXPECT_EQ(Flags::FindValueToString(8).ValueOr("?"), "?");
+
+    static_assert(Season::FindName("Winter").Get() == &Season::Winter, "constexpr find");
+    static_assert(Season::FindValue(1).Error() == SmartEnumErrc::ValueNotFound, "constexpr miss");
+}
+
+TEST(SmartFlagEnumTest, DecomposeSetBits)
+{
+    std::vector<const Flags *> visited;
+    for (const Flags &flag : Flags::Decompose(Flags::A | Flags::C))
+    {
+        visited.push_back(&flag);
+    }
+    EXPECT_EQ(visited, (std::vector<const Flags *>{&Flags::A, &Flags::C}));
+
+    auto all = Flags::Decompose(-1);
+    EXPECT_EQ(all.Size(), 3u);
+    EXPECT_EQ(all.UnmatchedBits(), ~7);
+    EXPECT_TRUE(Flags::Decompose(0).Empty());
+
+    auto partial = SparseFlags::Decompose(7);
+    EXPECT_EQ(partial.Size(), 2u);
+    EXPECT_EQ(partial.UnmatchedBits(), 2);
+    EXPECT_EQ(&*partial.begin(), &SparseFlags::Bit1);
+
+    // Exact matches keep their own name; other values list the largest flags first,
+    // taking a multi-bit flag such as AB when it fits, exactly as FromValue() does.
+    EXPECT_EQ(Flags::FromValueToString(3), "AB");
+    EXPECT_EQ(Flags::FromValueToString(5), "C, A");
+    EXPECT_EQ(Flags::FromValueToString(7), "C, AB");
+    EXPECT_EQ(Flags::FromValue(7), (std::vector<const Flags *>{&Flags::C, &Flags::AB}));
+    EXPECT_EQ(Flags::FromValueToString(0), "None");
+    EXPECT_EQ(SparseFlags::FromValueToString(5), "Bit3, Bit1");
+    EXPECT_EQ(LedFlags::FromValueToString(7), "Blue, Green, Red");
+
+    // The string always lists the names of FromValue(), in its order
+    for (int value = 0; value < 8; ++value)
+    {
+        std::string joined;
+        for (const Flags *flag : Flags::FromValue(value))
+        {
+            joined += (joined.empty() ? "" : ", ") + flag->Name();
+        }
+        EXPECT_EQ(Flags::FromValueToString(value), joined) << value;
+    }
+}
+
+TEST(SmartFlagEnumTest, FlagSetAlgebra)
+{
+    using FlagsSet = FlagSet<Flags>;
+    static_assert(std::is_trivially_copyable<FlagsSet>::value, "FlagSet is a plain value");
+    static_assert(sizeof(FlagsSet) == sizeof(Flags::ValueType), "FlagSet is as small as its value");
+    static_assert((FlagsSet(1) | FlagsSet(4)).HasAll(FlagsSet(5)), "constexpr algebra");
+    static_assert((FlagsSet(7) & ~FlagsSet(2)) == FlagsSet(5), "constexpr algebra");
+    static_assert((FlagsSet(5) ^ FlagsSet(4)).Count() == 1, "constexpr popcount");
+
+    FlagsSet granted = Flags::A | Flags::C;
+    EXPECT_TRUE(granted.HasFlag(Flags::A));
+    EXPECT_FALSE(granted.HasFlag(Flags::AB));
+    EXPECT_TRUE(granted.HasAny(Flags::AB));
+    EXPECT_FALSE(granted.HasAll(Flags::A | Flags::B));
+    EXPECT_EQ(granted.Count(), 2);
+    EXPECT_EQ(granted.Value(), 5);
+
+    granted |= Flags::B;
+    granted &= ~Flags::C;
+    EXPECT_TRUE(granted == Flags::AB);
+    EXPECT_EQ((Flags::AB ^ Flags::B).Value(), 1);
+    EXPECT_EQ((Flags::AB & Flags::B).Value(), 2);
+
+    int raw = Flags::A | Flags::B;
+    EXPECT_EQ(raw, 3);
+
+    EXPECT_EQ(FlagsSet(Flags::FromValue(5)), FlagsSet(5));
+    EXPECT_EQ(FlagsSet(5).ToList(), (std::vector<const Flags *>{&Flags::C, &Flags::A}));
+    EXPECT_EQ(FlagsSet(6).ToString(), "C, B");
+
+    std::vector<const Flags *> visited;
+    for (const Flags &flag : FlagsSet(6))
+    {
+        visited.push_back(&flag);
+    }
+    EXPECT_EQ(visited, (std::vector<const Flags *>{&Flags::B, &Flags::C}));
+}
+
+TEST(SmartFlagEnumTest, ParseNamesIntoMask)
+{
+    int mask = -7;
+    EXPECT_TRUE(Flags::TryFromName(" A | C ", mask));
+    EXPECT_EQ(mask, 5);
+    EXPECT_TRUE(Flags::TryFromName("a,b|c", mask, true));
+    EXPECT_EQ(mask, 7);
+    EXPECT_TRUE(Flags::TryFromName("AB, ,C", mask));
+    EXPECT_EQ(mask, 7);
+    EXPECT_TRUE(Flags::TryFromName("", mask));
+    EXPECT_EQ(mask, 0);
+
+    mask = 42;
+    EXPECT_FALSE(Flags::TryFromName("A|D", mask));
+    EXPECT_EQ(mask, 42);
+
+    FlagSet<Flags> flags;
+    EXPECT_TRUE(Flags::TryFromName("B|C", flags));
+    EXPECT_EQ(flags, Flags::B | Flags::C);
+
+    std::vector<const Flags *> list;
+    EXPECT_TRUE(Flags::TryFromName("C|A", list));
+    EXPECT_EQ(list, (std::vector<const Flags *>{&Flags::C, &Flags::A}));
+}
+
+TEST(SmartFlagEnumTest, FlagStringCache)
+{
+    std::string overflow;
+    FlagStringCache<Flags, 8> cache;
+    std::string_view first = cache.Format(5, overflow);
+    EXPECT_EQ(first, "C, A");
+    EXPECT_EQ(cache.Misses(), 1u);
+    std::string_view again = cache.Format(5, overflow);
+    EXPECT_EQ(again.data(), first.data());
+    EXPECT_EQ(cache.Hits(), 1u);
+
+    std::string_view text;
+    EXPECT_FALSE(cache.TryFormat(8, text, overflow));
+    EXPECT_THROW(cache.Format(8, overflow), InvalidFlagEnumValueParseException);
+    for (int value = 0; value < 8; ++value)
+    {
+        EXPECT_EQ(cache.Format(value, overflow), Flags::FromValueToString(value));
+    }
+
+    // One set of two entries: the first two values are cached and their views stay
+    // valid; later ones go to the caller's buffer and the cache does not grow
+    FlagStringCache<Flags, 2, 2> tiny;
+    const std::string_view one = tiny.Format(1, overflow);
+    const std::string_view five = tiny.Format(5, overflow);
+    for (int value = 0; value < 8; ++value)
+    {
+        const std::string_view formatted = tiny.Format(value, overflow);
+        EXPECT_EQ(formatted, Flags::FromValueToString(value));
+        EXPECT_EQ(formatted.data() == overflow.data(), value != 1 && value != 5) << value;
+    }
+    EXPECT_EQ(one, "A");
+    EXPECT_EQ(five, "C, A");
+    EXPECT_EQ(tiny.Format(1, overflow).data(), one.data());
+    EXPECT_EQ(tiny.Format(5, overflow).data(), five.data());
+    EXPECT_EQ(tiny.Hits(), 4u);
+    EXPECT_EQ(tiny.Misses(), 8u);
+
+    FlagStringCache<LedFlags> leds;
+    leds.PrecomputeAll();
+    EXPECT_EQ(leds.Format(0, overflow), "");
+    EXPECT_EQ(leds.Format(6, overflow), "Blue, Green");
+    EXPECT_FALSE(leds.TryFormat(8, text, overflow));
+    EXPECT_EQ(leds.Hits(), 2u);
+    EXPECT_EQ(leds.Misses(), 1u);
+
+    FlagStringCache<Flags, 4, 2> shared;
+    std::vector<std::thread> readers;
+    std::atomic<int> mismatches{0};
+    for (int t = 0; t < 4; ++t)
+    {
+        readers.emplace_back([&]
+        {
+            std::string spill;
+            for (int i = 0; i < 1000; ++i)
+            {
+                if (shared.Format(i % 8, spill) != Flags::FromValueToString(i % 8))
+                {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+    EXPECT_EQ(mismatches.load(), 0);
+    EXPECT_EQ(shared.Hits() + shared.Misses(), 4000u);
+}
+
+TEST(SmartFlagEnumTest, FullLookupTable)
+{
+    for (int value = 0; value < 256; ++value)
+    {
+        const auto tabled = StatusRegister::FindValue(static_cast<uint8_t>(value));
+        const auto untabled = StatusRegisterUntabled::FindValue(static_cast<uint8_t>(value));
+        ASSERT_EQ(tabled.Error(), untabled.Error()) << value;
+        if (!tabled)
+        {
+            continue;
+        }
+        ASSERT_EQ(tabled->size(), untabled->size()) << value;
+        for (size_t i = 0; i < tabled->size(); ++i)
+        {
+            EXPECT_EQ((*tabled)[i]->Name(), (*untabled)[i]->Name()) << value;
+        }
+        EXPECT_EQ(StatusRegister::FromValueToString(static_cast<uint8_t>(value)),
+                  StatusRegisterUntabled::FromValueToString(static_cast<uint8_t>(value)));
+    }
+
+    EXPECT_EQ(StatusRegister::FromValueToString(3), "ReadyBusy");
+    EXPECT_EQ(StatusRegister::FromValueToString(0x13), "Error, ReadyBusy");
+    EXPECT_EQ(StatusRegister::FromValueToString(0x71), "Fault, Error, Ready");
+    EXPECT_EQ(StatusRegister::FromValue(0x72), (std::vector<const StatusRegister *>{
+                                                   &statusRegisterFlags[5], &statusRegisterFlags[4],
+                                                   &statusRegisterFlags[2]}));
+    EXPECT_FALSE(StatusRegister::FindValue(0x20));
+    EXPECT_THROW(StatusRegister::FromValueToString(0x80), InvalidFlagEnumValueParseException);
+}
+
+TEST(SmartFlagEnumTest, FullLookupTableSkippedForManyFlags)
+{
+    ASSERT_TRUE(busRegisterDefined);
+    ASSERT_EQ(BusRegister::Count(), 40u);
+    for (unsigned value = 0; value < 0x10000; value += 251)
+    {
+        const auto tabled = BusRegister::FindValue(static_cast<uint16_t>(value));
+        const auto untabled = BusRegisterUntabled::FindValue(static_cast<uint16_t>(value));
+        ASSERT_EQ(tabled.Error(), untabled.Error()) << value;
+        ASSERT_EQ(tabled->size(), untabled->size()) << value;
+        EXPECT_EQ(BusRegister::FromValueToString(static_cast<uint16_t>(value)),
+                  BusRegisterUntabled::FromValueToString(static_cast<uint16_t>(value)));
+    }
+    EXPECT_EQ(BusRegister::FromValueToString(0x8003), "Line15, Pair0");
+}
+
+TEST(SmartFlagEnumTest, WideFlagBitset)
+{
+    using Bits = FlagBitset<150>;
+    static_assert(Bits::kWordCount == 3, "three 64-bit words");
+    static_assert((Bits::Bit(3) | Bits::Bit(140)).HasAll(Bits::Bit(140)), "constexpr algebra");
+    static_assert((~Bits()).Count() == 150, "complement stays within 150 bits");
+    static_assert(Bits::Bit(64) < Bits::Bit(65) && Bits::Bit(63) < Bits::Bit(64), "numeric order");
+
+    const Bits sparse = Bits::Bit(1) | Bits::Bit(70) | Bits::Bit(149);
+    std::vector<size_t> visited(sparse.begin(), sparse.end());
+    EXPECT_EQ(visited, (std::vector<size_t>{1, 70, 149}));
+    EXPECT_EQ(sparse.Count(), 3u);
+    EXPECT_TRUE(sparse.Test(70));
+    EXPECT_FALSE(sparse.Test(200));
+    EXPECT_EQ(Bits::Bit(68).ToString(), "0x100000000000000000");
+    EXPECT_THROW(Bits::Bit(150), std::out_of_range);
+}
+
+TEST(SmartFlagEnumTest, WideFlagEnum)
+{
+    const FlagBitset<150> both = Capability::Word0Top | Capability::Word1Bottom;
+    EXPECT_EQ(Capability::FromValueToString(both), "Word1Bottom, Word0Top");
+    EXPECT_EQ(Capability::FromValueToString(Capability::Edges), "Edges");
+    EXPECT_EQ(Capability::FromValue(both | Capability::Edges),
+              (std::vector<const Capability *>{&Capability::Edges, &Capability::Word1Bottom, &Capability::Word0Top}));
+
+    std::vector<const Capability *> flags;
+    EXPECT_TRUE(Capability::TryFromName("Last | word1bottom", flags, true));
+    EXPECT_EQ(flags, (std::vector<const Capability *>{&Capability::Last, &Capability::Word1Bottom}));
+
+    FlagBitset<150> mask;
+    EXPECT_TRUE(Capability::TryFromName("Base,Word0Top", mask));
+    EXPECT_EQ(mask, Capability::Base | Capability::Word0Top);
+    EXPECT_FALSE(Capability::TryFromName("Base,Missing", mask));
+
+    std::vector<const Capability *> decomposed;
+    for (const Capability &capability : Capability::Decompose(~FlagBitset<150>()))
+    {
+        decomposed.push_back(&capability);
+    }
+    EXPECT_EQ(decomposed, (std::vector<const Capability *>{&Capability::Base, &Capability::Word0Top,
+                                                           &Capability::Word1Bottom, &Capability::Last}));
+
+    EXPECT_EQ(Capability::FindValue(FlagBitset<150>::Bit(100)).Error(), SmartEnumErrc::InvalidFlagValue);
+    EXPECT_THROW(Capability::FromValueToString(FlagBitset<150>::Bit(2)), InvalidFlagEnumValueParseException);
+    EXPECT_EQ(Capability::FindName("Edges")->front(), &Capability::Edges);
+}
+
+TEST(SmartFlagEnumTest, WideFlagEnumSingleBits)
+{
+    static_assert(Lane::Flag<140>() == FlagBitset<150>::Bit(140), "Flag<B>() is the bit");
+    EXPECT_EQ(Lane::FromValue(Lane::Low | Lane::Mid | Lane::High),
+              (std::vector<const Lane *>{&Lane::High, &Lane::Mid, &Lane::Low}));
+    EXPECT_EQ(Lane::FromValueToString(Lane::Low | Lane::High), "High, Low");
+    EXPECT_EQ(Lane::FindValue(FlagBitset<150>::Bit(2)).Error(), SmartEnumErrc::InvalidFlagValue);
+    EXPECT_TRUE(Lane::FromValue(FlagBitset<150>()).empty());
+
+    const char buffer[] = "Mid|High and more";
+    EXPECT_EQ(Lane::FromName(buffer, 8), (std::vector<const Lane *>{&Lane::Mid, &Lane::High}));
+    std::vector<const Lane *> lanes;
+    EXPECT_TRUE(Lane::TryFromName(buffer, 3, lanes));
+    EXPECT_EQ(lanes, (std::vector<const Lane *>{&Lane::Mid}));
+    EXPECT_EQ(Lane::FindName(buffer, 10).Error(), SmartEnumErrc::NameNotFound);
+}
+
+TEST(SmartFlagEnumTest, AtomicFlagSet)
+{
+    AtomicFlagSet<Flags> state;
+    EXPECT_TRUE(state.Load().Empty());
+    EXPECT_EQ(state.Set(Flags::A | Flags::C), FlagSet<Flags>());
+    EXPECT_TRUE(state.Test(Flags::C, std::memory_order_acquire));
+    EXPECT_EQ(state.Clear(Flags::A, std::memory_order_release).Value(), 5);
+    EXPECT_EQ(state.Toggle(Flags::AB).Value(), 4);
+    EXPECT_EQ(state.Load().Value(), 7);
+
+    FlagSet<Flags> expected = Flags::A;
+    EXPECT_FALSE(state.CompareExchange(expected, Flags::B, std::memory_order_acq_rel, std::memory_order_acquire));
+    EXPECT_EQ(expected.Value(), 7);
+    EXPECT_TRUE(state.CompareExchange(expected, Flags::B));
+    EXPECT_EQ(state.Exchange(Flags::None).Value(), 2);
+
+    std::atomic<int> winners{0};
+    std::vector<std::thread> racers;
+    for (int t = 0; t < 8; ++t)
+    {
+        racers.emplace_back([&]
+        {
+            if (!state.TestAndSet(Flags::B, std::memory_order_acq_rel))
+            {
+                ++winners;
+            }
+        });
+    }
+    for (std::thread &racer : racers)
+    {
+        racer.join();
+    }
+    EXPECT_EQ(winners.load(), 1);
+
+    // Blocks with C++20 atomic waiting, polls before it
+    std::thread waiter([&] { EXPECT_TRUE(state.WaitFor(Flags::C, std::memory_order_acquire).HasFlag(Flags::C)); });
+    state.Set(Flags::A);
+    state.NotifyAll();
+    state.Set(Flags::C, std::memory_order_release);
+    state.NotifyAll();
+    waiter.join();
+
+    expected = state.Load(std::memory_order_relaxed);
+    while (!state.CompareExchangeWeak(expected, FlagSet<Flags>(), std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+    }
+    EXPECT_EQ(state.Load().Value(), 0);
+}
+
+TEST(SmartFlagEnumTest, CompileTimeFlagDefinitions)
+{
+    static_assert(Flags::Flag<4>() == 4, "single bits are accepted");
+    static_assert(Flags::Flag<-1>() == -1, "Flags allows negative values");
+    static_assert((Flags::Flag<1>() | Flags::Flag<2>()) == 3, "combinations of checked flags");
+    static_assert(SparseFlags::Flag<6>() == 6, "SparseFlags allows multi-bit values");
+    static_assert(LedFlags::Flag<0>() == 0, "zero is a valid flag");
+    static_assert(SmartEnumDetail::AllowsNegativeFlags<Flags>::value, "marker detected");
+    static_assert(!SmartEnumDetail::AllowsNegativeFlags<NoNegFlags>::value, "no marker");
+    static_assert(SmartEnumDetail::AllowsUnsafeFlags<SparseFlags>::value, "marker detected");
+
+    EXPECT_THROW(NoNegFlags("Negative", -4), NegativeFlagValueNotAllowedException);
+    EXPECT_EQ(NoNegFlags::FindName("Negative").Error(), SmartEnumErrc::NameNotFound);
+}
+
 TEST(SmartFlagEnumTest, AllowUnsafeFlagValues)
 {
 
@@ -275,6 +1147,301 @@ TEST(SmartEnumSwitchTest, FluentSwitch)
     EXPECT_EQ(result, "Default");
 }
 
+TEST(SmartEnumSwitchTest, MoveOnlyActions)
+{
+    // Actions are not wrapped in std::function, so they need not be copyable
+    auto counter = std::make_unique<int>(0);
+    auto bump = [owned = std::move(counter)]() mutable { return ++*owned; };
+    int seen = 0;
+    SwitchOn(TestEnum::One)
+        .When(TestEnum::One)
+        .Then([&seen, bump = std::move(bump)]() mutable
+              { seen = bump(); })
+        .Default([owned = std::make_unique<int>(7)]
+                 { FAIL() << "default must not run"; });
+    EXPECT_EQ(seen, 1);
+}
+
+TEST(SmartEnumSwitchTest, MultipleCandidates)
+{
+    auto classify = [](const TestEnum &value)
+    {
+        static const EnumSet<TestEnum> odd(TestEnum::One, TestEnum::Three);
+        std::string result;
+        SwitchOn(value)
+            .When(TestEnum::Two, TestEnum::Three)
+            .Then([&]
+                  { result = "TwoOrThree"; })
+            .When(odd)
+            .Then([&]
+                  { result = "Odd"; })
+            .Default([&]
+                     { result = "None"; });
+        return result;
+    };
+    EXPECT_EQ(classify(TestEnum::One), "Odd");
+    EXPECT_EQ(classify(TestEnum::Two), "TwoOrThree");
+    EXPECT_EQ(classify(TestEnum::Three), "TwoOrThree");
+
+    std::string result;
+    SwitchOn(TestEnum::Two)
+        .When(EnumSet<TestEnum>())
+        .Then([&]
+              { result = "Empty"; })
+        .When(TestEnum::One, TestEnum::Three, TestEnum::One)
+        .Then([&]
+              { result = "Listed"; })
+        .Default([&]
+                 { result = "Default"; });
+    EXPECT_EQ(result, "Default");
+}
+
+// Enum where two instances share a value
+class Signal : public SmartEnum<Signal>
+{
+public:
+    static const Signal Go;
+    static const Signal Green;
+    static const Signal Stop;
+
+private:
+    Signal(const std::string &name, int value) : SmartEnum(name, value) {}
+};
+const Signal Signal::Go("Go", 1);
+const Signal Signal::Green("Green", 1);
+const Signal Signal::Stop("Stop", 2);
+
+TEST(SmartEnumSwitchTest, AliasesMatchSingleCandidatesOnly)
+{
+    // Green shares Go's value: single-candidate cases compare values, several candidates and sets compare identity
+    ASSERT_EQ(Signal::Go.Value(), Signal::Green.Value());
+    const EnumSet<Signal> goOnly(Signal::Go);
+    auto classify = [&goOnly](const Signal &value)
+    {
+        std::vector<std::string> seen;
+        auto record = [&seen](const char *name)
+        { return [&seen, name]
+          { seen.push_back(name); }; };
+        SwitchOn(value).When(Signal::Go).Then(record("single")).Default(record("-"));
+        SwitchOn(value).When(Signal::Go, Signal::Stop).Then(record("several")).Default(record("-"));
+        SwitchOn(value).When(goOnly).Then(record("set")).Default(record("-"));
+        seen.push_back(Match<std::string>(value).When(Signal::Go, []
+                                                      { return std::string("match"); })
+                           .Otherwise([]
+                                      { return std::string("-"); }));
+        return seen;
+    };
+    EXPECT_EQ(classify(Signal::Go), (std::vector<std::string>{"single", "several", "set", "match"}));
+    EXPECT_EQ(classify(Signal::Green), (std::vector<std::string>{"single", "-", "-", "match"}));
+}
+
+TEST(SmartEnumSwitchTest, WhenFlags)
+{
+    const FlagSet<LedFlags> lit = LedFlags::Red | LedFlags::Green;
+    std::vector<std::string> seen;
+    auto record = [&seen](const char *name)
+    { return [&seen, name]
+      { seen.push_back(name); }; };
+
+    SwitchOn(lit).WhenFlags(LedFlags::Blue).Then(record("Blue")).Default(record("Dark"));
+    SwitchOn(lit).WhenFlags(LedFlags::Red | LedFlags::Blue).Then(record("Any")).Default(record("-"));
+    SwitchOn(lit).WhenFlags(LedFlags::Red | LedFlags::Blue, FlagMatch::All).Then(record("All")).Default(record("-"));
+    SwitchOn(lit).WhenFlags(LedFlags::Red | LedFlags::Green, FlagMatch::All).Then(record("All")).Default(record("-"));
+    EXPECT_EQ(seen, (std::vector<std::string>{"Dark", "Any", "-", "All"}));
+
+    // Switching on a flag instance, including FlagBitset-valued ones
+    bool any = false;
+    bool all = false;
+    SwitchOn(Capability::Edges).WhenFlags(Capability::Last).Then([&any]
+                                                                 { any = true; });
+    SwitchOn(Capability::Edges)
+        .WhenFlags(Capability::Base | Capability::Word1Bottom, FlagMatch::All)
+        .Then([&all]
+              { all = true; });
+    EXPECT_TRUE(any);
+    EXPECT_FALSE(all);
+}
+
+TEST(SmartEnumSwitchTest, MatchReturnsValue)
+{
+    auto describe = [](const TestEnum &value)
+    {
+        return Match<std::string>(value)
+            .When(TestEnum::One, []
+                  { return "one"; })
+            .When(TestEnum::Two, []
+                  { return std::string("two"); })
+            .Otherwise([]
+                       { return "other"; });
+    };
+    EXPECT_EQ(describe(TestEnum::One), "one");
+    EXPECT_EQ(describe(TestEnum::Two), "two");
+    EXPECT_EQ(describe(TestEnum::Three), "other");
+
+    // Only the matching action runs, and the first matching case wins
+    int calls = 0;
+    const int result = Match<int>(TestEnum::Two)
+                           .When(TestEnum::One, [&calls]
+                                 { return ++calls; })
+                           .When(TestEnum::Two, []
+                                 { return 2; })
+                           .When(TestEnum::Two, []
+                                 { return 22; })
+                           .Otherwise([&calls]
+                                      { return ++calls; });
+    EXPECT_EQ(result, 2);
+    EXPECT_EQ(calls, 0);
+
+    // Actions are held by value, so move-only captures are fine
+    const int owned = Match<int>(TestEnum::Three)
+                          .When(TestEnum::Three, [p = std::make_unique<int>(3)]
+                                { return *p; })
+                          .Otherwise([]
+                                     { return 0; });
+    EXPECT_EQ(owned, 3);
+}
+
+TEST(SmartEnumSwitchTest, MatchIsConstexpr)
+{
+    constexpr auto temperature = [](const Season &season)
+    {
+        return Match<int>(season)
+            .When(Season::Winter, []
+                  { return -5; })
+            .When(Season::Summer, []
+                  { return 30; })
+            .Otherwise([]
+                       { return 15; });
+    };
+    static_assert(temperature(Season::Winter) == -5, "constexpr match");
+    static_assert(temperature(Season::Summer) == 30, "constexpr match");
+    static_assert(temperature(Season::Autumn) == 15, "constexpr fallback");
+    EXPECT_EQ(temperature(Season::Spring), 15);
+}
+
+TEST(EnumDispatcherTest, DispatchesByOrdinal)
+{
+    int calls = 0;
+    const auto dispatcher = EnumDispatcher<TestEnum, int(int)>()
+                                .On(TestEnum::One, [](int x)
+                                    { return x + 1; })
+                                .On(TestEnum::Two, [&calls](int x)
+                                    { ++calls; return x * 2; })
+                                .Default([](int x)
+                                         { return -x; });
+
+    EXPECT_EQ(dispatcher(TestEnum::One, 10), 11);
+    EXPECT_EQ(dispatcher(TestEnum::Two, 10), 20);
+    EXPECT_EQ(dispatcher(TestEnum::Three, 10), -10);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(dispatcher.Size(), TestEnum::Count());
+
+    // Copies share the stored handlers
+    const auto copy = dispatcher;
+    EXPECT_EQ(copy(TestEnum::Two, 3), 6);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(EnumDispatcherTest, ForwardsArguments)
+{
+    EnumDispatcher<TestEnum, void(std::string &, std::unique_ptr<int>)> dispatcher;
+    dispatcher.On(TestEnum::One, [](std::string &out, std::unique_ptr<int> value)
+                  { out = std::to_string(*value); });
+
+    std::string out;
+    dispatcher(TestEnum::One, out, std::make_unique<int>(42));
+    EXPECT_EQ(out, "42");
+}
+
+TEST(EnumDispatcherTest, Exhaustiveness)
+{
+    EnumDispatcher<TestEnum, void()> dispatcher;
+    dispatcher.On(TestEnum::One, [] {}).On(TestEnum::Three, [] {});
+    EXPECT_TRUE(dispatcher.Handles(TestEnum::One));
+    EXPECT_FALSE(dispatcher.Handles(TestEnum::Two));
+    EXPECT_THROW(dispatcher.Exhaustive(), std::logic_error);
+    EXPECT_THROW(dispatcher(TestEnum::Two), std::out_of_range);
+
+    try
+    {
+        dispatcher.Exhaustive();
+    }
+    catch (const std::logic_error &e)
+    {
+        EXPECT_NE(std::string(e.what()).find("Two"), std::string::npos);
+    }
+
+    // A default covers the rest; a later On still overrides it
+    bool fallback = false;
+    dispatcher.Default([&fallback]
+                       { fallback = true; });
+    EXPECT_NO_THROW(dispatcher.Exhaustive());
+    dispatcher(TestEnum::Two);
+    EXPECT_TRUE(fallback);
+}
+
+TEST(EnumDispatcherTest, ReleasesReplacedHandlers)
+{
+    auto token = std::make_shared<int>(0);
+    auto holding = [&token](int result)
+    { return [held = token, result]
+      { return result; }; };
+
+    EnumDispatcher<TestEnum, int()> dispatcher;
+    dispatcher.Default(holding(0)).On(TestEnum::One, holding(1));
+    EXPECT_EQ(token.use_count(), 3);
+
+    // A second default and a second handler for One drop the ones they replace
+    dispatcher.Default(holding(10)).On(TestEnum::One, holding(11));
+    EXPECT_EQ(token.use_count(), 3);
+    EXPECT_EQ(dispatcher(TestEnum::One), 11);
+    EXPECT_EQ(dispatcher(TestEnum::Two), 10);
+
+    // Replacing a handler that falls back to the default keeps the default
+    dispatcher.On(TestEnum::Two, [] { return 2; });
+    EXPECT_EQ(token.use_count(), 3);
+    EXPECT_EQ(dispatcher(TestEnum::Three), 10);
+}
+
+TEST(EnumDispatcherTest, ForEachFlag)
+{
+    const auto onLed = EnumDispatcher<LedFlags, void(std::string &)>()
+                           .On(LedFlags::Red, [](std::string &out)
+                               { out += "R"; })
+                           .On(LedFlags::Green, [](std::string &out)
+                               { out += "G"; })
+                           .On(LedFlags::Blue, [](std::string &out)
+                               { out += "B"; })
+                           .Exhaustive();
+
+    std::string out;
+    EXPECT_EQ(ForEachFlag(LedFlags::Blue | LedFlags::Red, onLed, out), 0);
+    EXPECT_EQ(out, "RB");
+
+    // Undefined bits are skipped and reported
+    out.clear();
+    EXPECT_EQ(ForEachFlag(static_cast<uint8_t>(0x82), onLed, out), 0x80);
+    EXPECT_EQ(out, "G");
+
+    out.clear();
+    EXPECT_EQ(ForEachFlag(0, onLed, out), 0);
+    EXPECT_TRUE(out.empty());
+
+    // FlagBitset values walk their words the same way
+    std::vector<std::string> names;
+    const auto onCapability = EnumDispatcher<Capability, void()>().Default([] {});
+    EnumDispatcher<Capability, void(std::vector<std::string> &)> record;
+    record.On(Capability::Base, [](std::vector<std::string> &v)
+              { v.push_back("Base"); })
+        .On(Capability::Last, [](std::vector<std::string> &v)
+            { v.push_back("Last"); })
+        .Default([](std::vector<std::string> &v)
+                 { v.push_back("?"); });
+    EXPECT_TRUE(ForEachFlag(Capability::Edges, record, names).None());
+    EXPECT_EQ(names, (std::vector<std::string>{"Base", "Last"}));
+    EXPECT_TRUE(ForEachFlag(Capability::ValueType(), onCapability).None());
+}
+
 // Test for enums with same name in different namespaces
 TEST(SameNameEnumsTest, DifferentNamespaces) {
     // Test simple enum instances are distinct